@@ -0,0 +1,109 @@
+/********************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//          This program is free software : you can redistribute it and /or modify
+//          it under the terms of the GNU Affero General Public License as published by
+//          the Free Software Foundation, either version 3 of the License, or
+//          (at your option) any later version.
+//
+//          This program is distributed in the hope that it will be useful,
+//          but WITHOUT ANY WARRANTY; without even the implied warranty of
+//          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//          GNU Affero General Public License for more details.
+//
+//          You should have received a copy of the GNU Affero General Public License
+//          along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//          The author can be reached at: maxjmartin@gmail.com
+//
+/********************************************************************************************/
+
+#include <string>
+
+#include "oliver_lang.h"
+#include "benchmark.h"
+
+/*
+    Counts the heap allocations of arithmetic heavy workloads.  Scalars are held
+    within the var itself, so these should make no allocations once running.
+*/
+int main() {
+
+    using namespace Oliver;
+    using namespace Oliver::bench;
+
+    constexpr long long n = 1000000;
+
+    fmt::println("{:<32} {:>10} {:>12} {:>10} {:>10}", "workload", "operations", "allocations", "per op", "ms");
+
+    auto run = [](std::string_view name, long long ops, auto&& workload) {
+
+        const std::size_t before = allocations();
+
+        var result;
+
+        const double ms = milliseconds([&] { result = workload(); });
+
+        const std::size_t count = allocations() - before;
+
+        fmt::println("{:<32} {:>10} {:>12} {:>10.4f} {:>10.1f}   ({})", name, ops, count, double(count) / double(ops), ms, result);
+    };
+
+    run("integer sum", n, [] {
+        var sum{ number(0ll) };
+
+        for (long long i = 0; i < n; ++i) {
+            sum = sum + var(number(i));
+        }
+        return sum;
+    });
+
+    run("real product", n, [] {
+        const var factor{ number("1.000001") };
+
+        var product{ number(1ll) };
+
+        for (long long i = 0; i < n; ++i) {
+            product = product * factor;
+        }
+        return product;
+    });
+
+    run("integer multiply and modulo", 2 * n, [] {
+        var x{ number(1ll) };
+
+        for (long long i = 0; i < n; ++i) {
+            x = (x * var(number(31ll))) % var(number(1000003ll));
+        }
+        return x;
+    });
+
+    run("boolean exclusive or", n, [] {
+        var b{ boolean(false) };
+
+        for (long long i = 0; i < n; ++i) {
+            b = b ^ var(boolean(bool(i & 1)));
+        }
+        return b;
+    });
+
+    run("sum of a list, by lead and drop", 2 * n, [] {
+        var l{ list() };
+
+        for (long long i = 0; i < n; ++i) {
+            l = l.push(var(number(i)));
+        }
+
+        var sum{ number(0ll) };
+
+        while (l) {
+            sum = sum + l.lead();
+            l   = l.drop();
+        }
+        return sum;
+    });
+}
@@ -0,0 +1,90 @@
+/********************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//          This program is free software : you can redistribute it and /or modify
+//          it under the terms of the GNU Affero General Public License as published by
+//          the Free Software Foundation, either version 3 of the License, or
+//          (at your option) any later version.
+//
+//          This program is distributed in the hope that it will be useful,
+//          but WITHOUT ANY WARRANTY; without even the implied warranty of
+//          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//          GNU Affero General Public License for more details.
+//
+//          You should have received a copy of the GNU Affero General Public License
+//          along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//          The author can be reached at: maxjmartin@gmail.com
+//
+/********************************************************************************************/
+
+#include <cstdlib>
+#include <new>
+
+#include "benchmark.h"
+
+/*
+    Replaces the global 'operator new', aligned or not, with one which counts
+    each call.  The benchmarks are single threaded, so the count is not atomic.
+*/
+static std::size_t count = 0;
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"  // The replacements below do match.
+#endif
+
+void* operator new(std::size_t size) {
+
+    ++count;
+
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {  // As used by the default memory resource.
+
+    ++count;
+
+    const auto a = static_cast<std::size_t>(align);
+
+#if defined(_MSC_VER)
+    if (void* p = _aligned_malloc(size ? size : 1, a)) {
+        return p;
+    }
+#else
+    if (void* p = std::aligned_alloc(a, size ? (size + a - 1) / a * a : a)) {
+        return p;
+    }
+#endif
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+#if defined(_MSC_VER)
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t align) noexcept {
+    operator delete(p, align);
+}
+
+std::size_t Oliver::bench::allocations() noexcept {
+    return count;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+/*****************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//          This program is free software : you can redistribute it and /or modify
+//          it under the terms of the GNU Affero General Public License as published by
+//          the Free Software Foundation, either version 3 of the License, or
+//          (at your option) any later version.
+//
+//          This program is distributed in the hope that it will be useful,
+//          but WITHOUT ANY WARRANTY; without even the implied warranty of
+//          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//          GNU Affero General Public License for more details.
+//
+//          You should have received a copy of the GNU Affero General Public License
+//          along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//          The author can be reached at: maxjmartin@gmail.com
+//
+/*****************************************************************************************/
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Oliver::bench {
+
+    /********************************************************************************************/
+    //
+    //                                  Benchmark Support
+    //
+    //        Each benchmark is a small executable, which prints its own table of
+    //        results, along with a checksum of the work done so that it cannot be
+    //        optimized away.  They are built with OLIVER_BUILD_BENCHMARKS, and
+    //        should be run from a release build.
+    //
+    //        A benchmark linked with 'allocation_counter.cpp' replaces the global
+    //        'operator new', so 'allocations' counts every heap allocation made.
+    //
+    /********************************************************************************************/
+
+    std::size_t allocations() noexcept;  // Defined by 'allocation_counter.cpp'.
+
+    // The time taken by a call of 'f', in milliseconds.
+    template<typename F>
+    double milliseconds(F&& f) {
+
+        const auto start = std::chrono::steady_clock::now();
+
+        f();
+
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // The time taken by one call of 'f', in microseconds, averaged over at least 'ms' milliseconds.
+    template<typename F>
+    double microseconds_per_call(F&& f, double ms = 200.0) {
+
+        const auto start = std::chrono::steady_clock::now();
+
+        std::size_t calls = 0;
+        double      total = 0.0;
+
+        do {
+            f();
+            ++calls;
+            total = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        } while (total < ms * 1000.0);
+
+        return total / static_cast<double>(calls);
+    }
+}
@@ -0,0 +1,150 @@
+/********************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//          This program is free software : you can redistribute it and /or modify
+//          it under the terms of the GNU Affero General Public License as published by
+//          the Free Software Foundation, either version 3 of the License, or
+//          (at your option) any later version.
+//
+//          This program is distributed in the hope that it will be useful,
+//          but WITHOUT ANY WARRANTY; without even the implied warranty of
+//          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//          GNU Affero General Public License for more details.
+//
+//          You should have received a copy of the GNU Affero General Public License
+//          along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//          The author can be reached at: maxjmartin@gmail.com
+//
+/********************************************************************************************/
+
+#include <cmath>
+
+#include <boost/random.hpp>
+
+#include "oliver_lang.h"
+#include "benchmark.h"
+
+/*
+    Sweeps the operand size, to find where Toom-3 multiplication and Newton
+    division overtake the Boost.Multiprecision kernels.  Each compares one
+    level of the subquadratic method, over the Boost kernels, with the Boost
+    kernel alone.  So the size at which the ratio falls below one is where
+    'OLIVER_TOOM3_CUTOFF' and 'OLIVER_NEWTON_CUTOFF' belong.
+*/
+namespace {
+
+    using big_int = boost::multiprecision::cpp_int;
+
+    boost::random::mt19937 random(16);
+
+    big_int random_bits(std::size_t bits) {
+
+        boost::random::independent_bits_engine<boost::random::mt19937, 64, std::uint64_t> limbs(random());
+
+        big_int x = 0;
+
+        for (std::size_t i = 0; i < bits; i += 64) {
+            x <<= 64;
+            x  += limbs();
+        }
+
+        return (x >> ((bits + 63) / 64 * 64 - bits)) | (big_int(1) << (bits - 1));
+    }
+
+    /*
+        The quotient of 'a' by the 'n' bit 'b', as 'big_divide' computes it for a
+        divisor just above the cutoff.  The reciprocal is one Newton step from the
+        reciprocal of the upper half of 'b', which is computed by Boost.
+    */
+    big_int newton_quotient(const big_int& a, const big_int& b) {
+
+        using namespace Oliver;
+
+        const std::size_t n = big_bits(b);
+        const std::size_t h = n / 2 + 1;
+
+        big_int r = ((big_int(1) << (2 * h)) / (b >> (n - h))) << (n - h);
+
+        const big_int one = big_int(1) << (2 * n);
+
+        big_int e = one - big_multiply(b, r);
+
+        r += big_multiply(r, e) >> (2 * n);
+        e  = one - big_multiply(b, r);
+
+        while (e.sign() < 0) {
+            --r;
+            e += b;
+        }
+
+        while (e >= b) {
+            ++r;
+            e -= b;
+        }
+
+        const std::size_t blocks = (big_bits(a) + n - 1) / n;
+        const big_int     mask   = (big_int(1) << n) - 1;
+
+        big_int q   = 0;
+        big_int rem = 0;
+
+        for (std::size_t i = blocks; i-- > 0;) {
+
+            big_int digit;
+
+            big_divide_block(big_int((rem << n) | ((a >> (i * n)) & mask)), b, r, n, digit, rem);
+
+            q <<= n;
+            q  += digit;
+        }
+
+        return q;
+    }
+}
+
+int main() {
+
+    using namespace Oliver;
+    using namespace Oliver::bench;
+
+    fmt::println("OLIVER_TOOM3_CUTOFF = {} bits, OLIVER_NEWTON_CUTOFF = {} bits\n", OLIVER_TOOM3_CUTOFF, OLIVER_NEWTON_CUTOFF);
+
+    fmt::println("{:>8} {:>8}   {:>12} {:>12} {:>6}   {:>12} {:>12} {:>6}",
+                 "bits", "digits", "a * b us", "toom-3 us", "ratio", "a / b us", "newton us", "ratio");
+
+    std::size_t mismatches = 0;
+
+    for (std::size_t bits : { 1024, 2048, 4096, 6144, 8192, 12288, 16384, 24576, 32768, 49152, 65536, 98304, 131072 }) {
+
+        const big_int a = random_bits(bits);
+        const big_int b = random_bits(bits);
+
+        big_int product;
+
+        const double mul   = microseconds_per_call([&] { product = a * b; });
+        const double toom3 = microseconds_per_call([&] { product = toom3_multiply(a, b); });
+
+        mismatches += product != a * b;
+
+        // A quotient of twice the divisor's width, as in each block of 'big_divide'.
+        const big_int n = random_bits(3 * bits);
+        const big_int d = b;
+
+        big_int quotient;
+
+        const double div    = microseconds_per_call([&] { quotient = n / d; });
+        const double newton = microseconds_per_call([&] { quotient = newton_quotient(n, d); });
+
+        mismatches += quotient != n / d;
+
+        fmt::println("{:>8} {:>8}   {:>12.1f} {:>12.1f} {:>6.2f}   {:>12.1f} {:>12.1f} {:>6.2f}",
+                     bits, static_cast<std::size_t>(bits * std::log10(2.0)), mul, toom3, toom3 / mul, div, newton, newton / div);
+    }
+
+    fmt::println("\nmismatches: {}", mismatches);
+}
@@ -0,0 +1,98 @@
+/********************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//          This program is free software : you can redistribute it and /or modify
+//          it under the terms of the GNU Affero General Public License as published by
+//          the Free Software Foundation, either version 3 of the License, or
+//          (at your option) any later version.
+//
+//          This program is distributed in the hope that it will be useful,
+//          but WITHOUT ANY WARRANTY; without even the implied warranty of
+//          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//          GNU Affero General Public License for more details.
+//
+//          You should have received a copy of the GNU Affero General Public License
+//          along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//          The author can be reached at: maxjmartin@gmail.com
+//
+/********************************************************************************************/
+
+#include <string_view>
+
+#include "oliver_lang.h"
+#include "benchmark.h"
+
+/*
+    Counts the payloads cloned by evaluating an expression.  A 'probe' counts
+    each time it is copied, so a list of probes counts the elements copied when
+    the list is.  Operands are passed by reference, and an rvalue operand is
+    moved from, so only the copies an expression needs should be counted.
+*/
+namespace {
+
+    std::size_t clones = 0;
+
+    struct probe {
+        probe() = default;
+        probe(const probe&) { ++clones; }
+        probe(probe&&) noexcept = default;
+
+        probe& operator=(const probe&) { ++clones; return *this; }
+        probe& operator=(probe&&) noexcept = default;
+    };
+}
+
+int main() {
+
+    using namespace Oliver;
+
+#ifdef OLIVER_COPY_ON_WRITE
+    fmt::println("Copy on write: on\n");
+#else
+    fmt::println("Copy on write: off\n");
+#endif
+
+    constexpr std::size_t n = 100;  // The probes in each list.
+
+    var x{ list() };
+    var y{ list() };
+
+    for (std::size_t i = 0; i < n; ++i) {
+        x = x.push(var(probe()));
+        y = y.push(var(probe()));
+    }
+
+    fmt::println("{:<40} {:>8}", "expression, of lists of 100 probes", "clones");
+
+    struct operands {
+        var a;  // A copy of 'x'.
+        var b;  // A copy of 'y'.
+        var p;  // A probe.
+    };
+
+    // The operands are made before counting.
+    auto run = [&](std::string_view name, auto&& expression) {
+
+        operands o{ x, y, var(probe()) };
+
+        const std::size_t before = clones;
+
+        var result = expression(o);
+
+        fmt::println("{:<40} {:>8}", name, clones - before);
+    };
+
+    run("var r = a",            [](operands& o) { return o.a; });
+    run("a + b",                [](operands& o) { return o.a + o.b; });
+    run("a + std::move(b)",     [](operands& o) { return o.a + std::move(o.b); });
+    run("a.push(p)",            [](operands& o) { return o.a.push(o.p); });
+    run("a.push(std::move(p))", [](operands& o) { return o.a.push(std::move(o.p)); });
+    run("a.lead()",             [](operands& o) { return o.a.lead(); });
+    run("a.drop()",             [](operands& o) { return o.a.drop(); });
+    run("a.reverse()",          [](operands& o) { return o.a.reverse(); });
+}
@@ -0,0 +1,139 @@
+/********************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//          This program is free software : you can redistribute it and /or modify
+//          it under the terms of the GNU Affero General Public License as published by
+//          the Free Software Foundation, either version 3 of the License, or
+//          (at your option) any later version.
+//
+//          This program is distributed in the hope that it will be useful,
+//          but WITHOUT ANY WARRANTY; without even the implied warranty of
+//          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//          GNU Affero General Public License for more details.
+//
+//          You should have received a copy of the GNU Affero General Public License
+//          along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//          The author can be reached at: maxjmartin@gmail.com
+//
+/********************************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "oliver_lang.h"
+#include "benchmark.h"
+
+/*
+    The accuracy and throughput of the batch elementary functions in 'Simd.h',
+    against the C library.  The error is the largest difference in ulps, of
+    the C library's result, over uniform arguments in each function's range
+    and over arguments of every exponent.  The bounds are those documented
+    with 'lane_fn'.
+*/
+namespace {
+
+    using elementary = double (*)(double);
+
+    double ulps(double x, double expected) {
+
+        if (x == expected || (std::isnan(x) && std::isnan(expected))) {
+            return 0.0;
+        }
+
+        if (!std::isfinite(x) || !std::isfinite(expected)) {
+            return std::numeric_limits<double>::infinity();
+        }
+
+        const double a   = std::fabs(expected);
+        const double ulp = std::nextafter(a, std::numeric_limits<double>::infinity()) - a;
+
+        return std::fabs(x - expected) / ulp;
+    }
+}
+
+int main() {
+
+    using namespace Oliver;
+    using namespace Oliver::bench;
+
+    struct function {
+        lane_fn      fn;
+        elementary   libm;
+        const char*  name;
+        double       lo;
+        double       hi;
+        double       bound;
+    };
+
+    const function functions[] = {
+        { lane_fn::exp,  [](double x) { return std::exp(x);  }, "exp",  -745.0, 709.0, 1.0 },
+        { lane_fn::log,  [](double x) { return std::log(x);  }, "log",   0.0,   1e300, 1.0 },
+        { lane_fn::sin,  [](double x) { return std::sin(x);  }, "sin",  -1e6,   1e6,   2.0 },
+        { lane_fn::cos,  [](double x) { return std::cos(x);  }, "cos",  -1e6,   1e6,   2.0 },
+        { lane_fn::tan,  [](double x) { return std::tan(x);  }, "tan",  -1e6,   1e6,   4.0 },
+        { lane_fn::sinh, [](double x) { return std::sinh(x); }, "sinh", -710.0, 710.0, 2.0 },
+        { lane_fn::cosh, [](double x) { return std::cosh(x); }, "cosh", -710.0, 710.0, 2.0 },
+        { lane_fn::tanh, [](double x) { return std::tanh(x); }, "tanh", -30.0,  30.0,  4.0 },
+    };
+
+    constexpr std::size_t n = 1 << 20;
+
+    std::mt19937_64    random(20);
+    std::vector<double> in(n);
+    std::vector<double> out(n);
+
+    fmt::println("{:<6} {:>10} {:>10} {:>12} {:>12} {:>8}", "fn", "max ulp", "bound", "batch ns", "libm ns", "speedup");
+
+    bool within = true;
+
+    for (const function& f : functions) {
+
+        double worst = 0.0;
+
+        // Uniform over the range, then of every exponent with a random sign.
+        for (int pass = 0; pass < 2; ++pass) {
+
+            std::uniform_real_distribution<double> uniform(f.lo, f.hi);
+            std::uniform_real_distribution<double> mantissa(0.5, 1.0);
+
+            for (double& x : in) {
+                x = pass == 0 ? uniform(random)
+                              : std::ldexp(random() & 1 ? -mantissa(random) : mantissa(random), static_cast<int>(random() % 2100) - 1075);
+            }
+
+            simd_apply(f.fn, in.data(), out.data(), n);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                worst = std::max(worst, ulps(out[i], f.libm(in[i])));
+            }
+        }
+
+        within = within && worst <= f.bound;
+
+        // The throughput over the uniform arguments.
+        std::uniform_real_distribution<double> uniform(f.lo, f.hi);
+
+        for (double& x : in) {
+            x = uniform(random);
+        }
+
+        const double batch = milliseconds([&] { simd_apply(f.fn, in.data(), out.data(), n); });
+        const double libm  = milliseconds([&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                out[i] = f.libm(in[i]);
+            }
+        });
+
+        fmt::println("{:<6} {:>10.2f} {:>10.0f} {:>12.2f} {:>12.2f} {:>8.2f}", f.name, worst, f.bound, batch * 1e6 / n, libm * 1e6 / n, libm / batch);
+    }
+
+    fmt::println("\nwithin the documented bounds: {}", within);
+}
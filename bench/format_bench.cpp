@@ -0,0 +1,149 @@
+/********************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//          This program is free software : you can redistribute it and /or modify
+//          it under the terms of the GNU Affero General Public License as published by
+//          the Free Software Foundation, either version 3 of the License, or
+//          (at your option) any later version.
+//
+//          This program is distributed in the hope that it will be useful,
+//          but WITHOUT ANY WARRANTY; without even the implied warranty of
+//          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//          GNU Affero General Public License for more details.
+//
+//          You should have received a copy of the GNU Affero General Public License
+//          along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//          The author can be reached at: maxjmartin@gmail.com
+//
+/********************************************************************************************/
+
+#include <complex>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "oliver_lang.h"
+#include "benchmark.h"
+
+/*
+    The throughput of printing large lists of numbers, and an expression of
+    nested lists, into a reused 'fmt::memory_buffer', with the allocations
+    made.  Each is printed with the default format and with a fixed width
+    and precision.  Formatting each element to a 'std::string', as numbers
+    were printed before they wrote to a buffer, is given for scale.
+*/
+int main() {
+
+    using namespace Oliver;
+    using namespace Oliver::bench;
+
+    constexpr std::size_t n = 1 << 17;
+
+    std::mt19937_64                        random(14);
+    std::uniform_int_distribution<int>     digits(-999999, 999999);
+    std::uniform_real_distribution<double> real(-1e6, 1e6);
+
+    auto make = [](auto&& element) {
+
+        var l{ list() };
+
+        for (std::size_t i = 0; i < n; ++i) {
+            l = l.push(element());
+        }
+        return l;
+    };
+
+    auto literal = [](const std::string& str) { return var(number(str)); };
+
+    struct workload {
+        std::string_view name;
+        var              values;
+    };
+
+    workload workloads[] = {
+        { "integers",   make([&] { return var(number(static_cast<long long>(digits(random)))); }) },
+        { "reals",      make([&] { return var(number(std::complex<double>(real(random), 0.0))); }) },
+        { "decimals",   make([&] { return literal(fmt::format("{}.{:02}d", digits(random), digits(random) & 63)); }) },
+        { "rationals",  make([&] { return literal(fmt::format("{}/{}", digits(random), digits(random) & 1023 | 1)); }) },
+        { "complex",    make([&] { return var(number(std::complex<double>(real(random), real(random)))); }) },
+        { "expression", var() },
+    };
+
+    // An expression of small lists of reals, with 'n' numbers in all.
+    var e{ expression() };
+
+    for (std::size_t i = 0; i < n / 8; ++i) {
+
+        var l{ list() };
+
+        for (std::size_t j = 0; j < 8; ++j) {
+            l = l.push(var(number(std::complex<double>(real(random), 0.0))));
+        }
+        e = e.push(std::move(l));
+    }
+    workloads[5].values = std::move(e);
+
+    // The specifications are parsed as 'fmt' would, for the 'var' formatter.
+    auto args = [](std::string_view spec) {
+
+        fmt::formatter<var>       f;
+        fmt::format_parse_context ctx(spec);
+
+        f.parse(ctx);
+
+        return f.fmt_args;
+    };
+
+    struct format {
+        std::string_view spec;
+        Format_Args      args;
+    };
+
+    const format formats[] = {
+        { "{}",         args("") },
+        { "{:>14.3f}",  args(">14.3f") },
+    };
+
+    fmt::println("{:<12} {:<10} {:>12} {:>10} {:>14} {:>14}", "numbers", "format", "ns each", "MB/s", "allocations", "string ns");
+
+    fmt::memory_buffer out;
+
+    for (const workload& w : workloads) {
+        for (const format& f : formats) {
+
+            out.clear();
+
+            w.values.write(out, f.args);  // Once to grow the buffer.
+
+            const std::size_t bytes  = out.size();
+            const std::size_t before = allocations();
+
+            const double ms = milliseconds([&] {
+                out.clear();
+                w.values.write(out, f.args);
+            });
+
+            const std::size_t count = allocations() - before;
+
+            // Each element formatted to its own string, then appended.
+            std::string str;
+            var         rest = w.values;
+
+            const double each = milliseconds([&] {
+                while (rest) {
+                    str += rest.lead().str(f.args);
+                    rest = rest.drop();
+                }
+            });
+
+            fmt::println("{:<12} {:<10} {:>12.1f} {:>10.1f} {:>14} {:>14.1f}   ({})", w.name, f.spec, ms * 1e6 / n, bytes / ms / 1e3,
+                         count, each * 1e6 / n, str.size());
+        }
+    }
+}
@@ -0,0 +1,126 @@
+/********************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//          This program is free software : you can redistribute it and /or modify
+//          it under the terms of the GNU Affero General Public License as published by
+//          the Free Software Foundation, either version 3 of the License, or
+//          (at your option) any later version.
+//
+//          This program is distributed in the hope that it will be useful,
+//          but WITHOUT ANY WARRANTY; without even the implied warranty of
+//          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//          GNU Affero General Public License for more details.
+//
+//          You should have received a copy of the GNU Affero General Public License
+//          along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//          The author can be reached at: maxjmartin@gmail.com
+//
+/********************************************************************************************/
+
+#include <complex>
+#include <random>
+#include <vector>
+
+#include "oliver_lang.h"
+#include "benchmark.h"
+
+/*
+    The throughput of a mixed workload of reals and complex numbers, through
+    var.  Each step computes '(a * b + c) / d ^ e', which runs a complex
+    division and a complex power whenever one operand has an imaginary part.
+    Before reals were kept off the complex path, every number paid for those,
+    so the speedup is against the workload which is entirely complex.  The
+    same steps on bare 'std::complex<double>' and 'double' show the cost of
+    the arithmetic alone.
+*/
+int main() {
+
+    using namespace Oliver;
+    using namespace Oliver::bench;
+
+    constexpr std::size_t n    = 1 << 19;
+    constexpr std::size_t size = 1024;
+
+    std::mt19937_64                        random(12);
+    std::uniform_real_distribution<double> part(0.5, 2.0);
+
+    double checksum = 0.0;
+
+    auto step = [](auto a, auto b, auto c, auto d, auto e) {
+        using std::pow;
+        return (a * b + c) / pow(d, e);
+    };
+
+    struct result {
+        double number;    // Nanoseconds per step, through var.
+        double complex;   // On bare 'std::complex<double>'.
+        double real;      // On bare 'double', of the real parts.
+    };
+
+    // The times of one step, when a fraction 'complex' of the operands are complex.
+    auto run = [&](double complex) {
+
+        std::bernoulli_distribution is_complex(complex);
+
+        std::vector<std::complex<double>> operands;
+        std::vector<var>                  numbers;
+
+        for (std::size_t i = 0; i < size; ++i) {
+            operands.emplace_back(part(random), is_complex(random) ? part(random) : 0.0);
+            numbers.emplace_back(number(operands.back()));
+        }
+
+        std::size_t          count = 0;
+        std::complex<double> sum;
+        double               real  = 0.0;
+
+        const double boxed = milliseconds([&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                var a = numbers[i % size];
+                var d = numbers[(i + 3) % size];
+                var q = a * numbers[(i + 1) % size] + numbers[(i + 2) % size];
+                count += (q / d.pow(numbers[(i + 4) % size])).is_something();
+            }
+        });
+
+        const double bare = milliseconds([&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += step(operands[i % size], operands[(i + 1) % size], operands[(i + 2) % size],
+                            operands[(i + 3) % size], operands[(i + 4) % size]);
+            }
+        });
+
+        const double scalar = milliseconds([&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                real += step(operands[i % size].real(), operands[(i + 1) % size].real(), operands[(i + 2) % size].real(),
+                             operands[(i + 3) % size].real(), operands[(i + 4) % size].real());
+            }
+        });
+
+        checksum += static_cast<double>(count) + sum.real() + real;
+
+        return result{ boxed * 1e6 / n, bare * 1e6 / n, scalar * 1e6 / n };
+    };
+
+    const double fractions[] = { 1.0, 0.5, 0.1, 0.01, 0.0 };
+
+    std::vector<result> results;
+
+    for (double complex : fractions) {
+        results.push_back(run(complex));
+    }
+
+    fmt::println("{:>9} {:>12} {:>10} {:>14} {:>10}", "complex", "number ns", "speedup", "std::complex", "double");
+
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        fmt::println("{:>8.0f}% {:>12.2f} {:>10.2f} {:>14.2f} {:>10.2f}", fractions[i] * 100, results[i].number,
+                     results[0].number / results[i].number, results[i].complex, results[i].real);
+    }
+
+    fmt::println("\nchecksum: {:.6g}", checksum);
+}
@@ -0,0 +1,88 @@
+/********************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//          This program is free software : you can redistribute it and /or modify
+//          it under the terms of the GNU Affero General Public License as published by
+//          the Free Software Foundation, either version 3 of the License, or
+//          (at your option) any later version.
+//
+//          This program is distributed in the hope that it will be useful,
+//          but WITHOUT ANY WARRANTY; without even the implied warranty of
+//          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//          GNU Affero General Public License for more details.
+//
+//          You should have received a copy of the GNU Affero General Public License
+//          along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//          The author can be reached at: maxjmartin@gmail.com
+//
+/********************************************************************************************/
+
+#include <string_view>
+#include <vector>
+
+#include "oliver_lang.h"
+#include "benchmark.h"
+
+/*
+    The throughput of 'number + number' through var, for each kind of number.
+    Each addition checks the type of both operands, so this also measures the
+    cost of 'cast<T>()' and the infix table lookup.
+*/
+int main() {
+
+    using namespace Oliver;
+    using namespace Oliver::bench;
+
+    constexpr std::size_t n = 1 << 20;
+
+    fmt::println("{:<20} {:>10} {:>10}", "operands", "ns per +", "checksum");
+
+    auto run = [](std::string_view name, const var& x, const var& y) {
+
+        var sum;
+
+        const double ms = milliseconds([&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                var a = x;
+                sum = a + y;
+            }
+        });
+
+        fmt::println("{:<20} {:>10.2f} {:>10}", name, ms * 1e6 / n, sum);
+    };
+
+    run("integer",  var(number(123456789ll)), var(number(987654321ll)));
+    run("real",     var(number("1.25")),      var(number("2.5")));
+    run("rational", var(number("1/3")),       var(number("1/6")));
+    run("decimal",  var(number("1.25d")),     var(number("2.5d")));
+    run("complex",  var(number("1+2j")),      var(number("3-1j")));
+
+    // The type check alone, on a hit and on a miss, over values which stay in cache.
+    const std::vector<var> values(1024, var(number(1ll)));
+
+    std::size_t hits = 0;
+
+    const double hit = milliseconds([&] {
+        for (std::size_t i = 0; i < n; i += values.size()) {
+            for (const var& v : values) {
+                hits += v.cast<number>() != nullptr;
+            }
+        }
+    });
+
+    const double miss = milliseconds([&] {
+        for (std::size_t i = 0; i < n; i += values.size()) {
+            for (const var& v : values) {
+                hits += v.cast<text>() != nullptr;
+            }
+        }
+    });
+
+    fmt::println("{:<20} {:>10.2f} {:>10}", "cast<T> hit", hit * 1e6 / n, hits);
+    fmt::println("{:<20} {:>10.2f} {:>10}", "cast<T> miss", miss * 1e6 / n, hits);
+}
@@ -0,0 +1,103 @@
+/********************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//          This program is free software : you can redistribute it and /or modify
+//          it under the terms of the GNU Affero General Public License as published by
+//          the Free Software Foundation, either version 3 of the License, or
+//          (at your option) any later version.
+//
+//          This program is distributed in the hope that it will be useful,
+//          but WITHOUT ANY WARRANTY; without even the implied warranty of
+//          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//          GNU Affero General Public License for more details.
+//
+//          You should have received a copy of the GNU Affero General Public License
+//          along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//          The author can be reached at: maxjmartin@gmail.com
+//
+/********************************************************************************************/
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "oliver_lang.h"
+#include "benchmark.h"
+
+/*
+    The throughput of parsing numeric literals, and the allocations made.  A
+    literal which fits an int64, a double, or a pair of them, should parse
+    without allocating.
+*/
+int main() {
+
+    using namespace Oliver;
+    using namespace Oliver::bench;
+
+    constexpr std::size_t n = 1 << 21;
+
+    std::mt19937_64 random(13);
+
+    auto literals = [&](auto&& make) {
+
+        std::vector<std::string> result;
+
+        result.reserve(n);
+
+        for (std::size_t i = 0; i < n; ++i) {
+            result.push_back(make());
+        }
+        return result;
+    };
+
+    auto integer = [&] { return std::to_string(static_cast<long long>(random() >> 20) - (1ll << 43)); };
+    auto real    = [&] { return fmt::format("{}", std::uniform_real_distribution<double>(-1e6, 1e6)(random)); };
+
+    struct workload {
+        std::string_view         name;
+        std::vector<std::string> literals;
+    };
+
+    const workload workloads[] = {
+        { "integer",          literals(integer) },
+        { "real",             literals(real) },
+        { "exponent",         literals([&] { return fmt::format("{:e}", std::uniform_real_distribution<double>(-1e6, 1e6)(random)); }) },
+        { "imaginary",        literals([&] { return real() + "j"; }) },
+        { "complex a+bj",     literals([&] { return real() + "+" + real() + "j"; }) },
+        { "complex (a,bj)",   literals([&] { return "(" + real() + ", " + real() + "j)"; }) },
+        { "rational",         literals([&] { return integer() + "/" + std::to_string(random() % 1000 + 1); }) },
+        { "nan and inf",      literals([&] { return random() & 1 ? "nan"s : "-inf"s; }) },
+        { "big integer",      literals([&] { return std::to_string(random()) + std::to_string(random()); }) },
+    };
+
+    fmt::println("{:<16} {:>12} {:>12} {:>14}", "literals", "ns each", "MB/s", "allocations");
+
+    for (const workload& w : workloads) {
+
+        std::size_t bytes = 0;
+        std::size_t kinds = 0;
+
+        for (const std::string& s : w.literals) {
+            bytes += s.size();
+        }
+
+        const std::size_t before = allocations();
+
+        const double ms = milliseconds([&] {
+            for (const std::string& s : w.literals) {
+                const number x(s);
+                kinds += _is_(x);
+            }
+        });
+
+        const std::size_t count = allocations() - before;
+
+        fmt::println("{:<16} {:>12.1f} {:>12.1f} {:>14}   ({})", w.name, ms * 1e6 / n, bytes / ms / 1e3, count, kinds);
+    }
+}
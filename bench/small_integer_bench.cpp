@@ -0,0 +1,110 @@
+/********************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//          This program is free software : you can redistribute it and /or modify
+//          it under the terms of the GNU Affero General Public License as published by
+//          the Free Software Foundation, either version 3 of the License, or
+//          (at your option) any later version.
+//
+//          This program is distributed in the hope that it will be useful,
+//          but WITHOUT ANY WARRANTY; without even the implied warranty of
+//          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//          GNU Affero General Public License for more details.
+//
+//          You should have received a copy of the GNU Affero General Public License
+//          along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//          The author can be reached at: maxjmartin@gmail.com
+//
+/********************************************************************************************/
+
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "oliver_lang.h"
+#include "benchmark.h"
+
+/*
+    The cost of arithmetic on small integers, the common case, through var.
+    Each operator is timed on int64 operands, and on complex operands with a
+    non-zero imaginary part, whose arithmetic is the 'std::complex<double>'
+    every number held before the tagged representation.  So a ratio of at
+    most one shows that the integer path is no slower than before.  The last
+    row sums integers which overflow, to time the promotion to a big integer.
+*/
+int main() {
+
+    using namespace Oliver;
+    using namespace Oliver::bench;
+
+    constexpr std::size_t n    = 1 << 20;
+    constexpr std::size_t size = 1024;
+
+    std::mt19937_64 random(11);
+
+    std::uniform_int_distribution<long long> small(1, 1 << 20);
+    std::uniform_real_distribution<double>   part(1.0, double(1 << 20));
+
+    std::vector<var> integers;
+    std::vector<var> complexes;
+    std::vector<var> large;
+
+    for (std::size_t i = 0; i < size; ++i) {
+        integers.emplace_back(number(small(random)));
+        complexes.emplace_back(number(std::complex<double>(part(random), part(random))));
+        large.emplace_back(number(static_cast<long long>(random() >> 1)));
+    }
+
+    using operation = var (*)(var&, const var&);
+
+    struct row {
+        std::string_view name;
+        operation        op;
+    };
+
+    const row rows[] = {
+        { "+",  [](var& a, const var& b) { return a + b; } },
+        { "-",  [](var& a, const var& b) { return a - b; } },
+        { "*",  [](var& a, const var& b) { return a * b; } },
+        { "/",  [](var& a, const var& b) { return a / b; } },
+        { "%",  [](var& a, const var& b) { return a % b; } },
+        { "<",  [](var& a, const var& b) { return var(boolean(a < b)); } },
+        { "==", [](var& a, const var& b) { return var(boolean(a == b)); } },
+    };
+
+    // The time of one 'op' in nanoseconds, over every pair of adjacent operands.
+    auto time = [&](operation op, std::vector<var>& values) {
+
+        std::size_t something = 0;
+
+        const double ms = milliseconds([&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                var a = values[i % size];
+                something += op(a, values[(i + 1) % size]).is_something();
+            }
+        });
+
+        return std::pair(ms * 1e6 / n, something);
+    };
+
+    fmt::println("{:<6} {:>12} {:>12} {:>8} {:>10}", "op", "int64 ns", "complex ns", "ratio", "checksum");
+
+    for (const row& r : rows) {
+
+        const auto [integer, a] = time(r.op, integers);
+        const auto [complex, b] = time(r.op, complexes);
+
+        fmt::println("{:<6} {:>12.2f} {:>12.2f} {:>8.2f} {:>10}", r.name, integer, complex, integer / complex, a + b);
+    }
+
+    const auto [overflow, c] = time(rows[0].op, large);
+
+    fmt::println("\n{:<6} {:>12.2f} {:>12} {:>8} {:>10}", "+ big", overflow, "", "", c);
+}
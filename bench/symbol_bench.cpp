@@ -0,0 +1,147 @@
+/********************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//          This program is free software : you can redistribute it and /or modify
+//          it under the terms of the GNU Affero General Public License as published by
+//          the Free Software Foundation, either version 3 of the License, or
+//          (at your option) any later version.
+//
+//          This program is distributed in the hope that it will be useful,
+//          but WITHOUT ANY WARRANTY; without even the implied warranty of
+//          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//          GNU Affero General Public License for more details.
+//
+//          You should have received a copy of the GNU Affero General Public License
+//          along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//          The author can be reached at: maxjmartin@gmail.com
+//
+/********************************************************************************************/
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "oliver_lang.h"
+#include "benchmark.h"
+
+/*
+    Compares interned symbols with the strings they name.  Two symbols are
+    equal when their ids are, and an environment keyed by id hashes an
+    integer, so neither should depend on the length of the name.  The names
+    share a long prefix, which is the worst case for comparing strings.
+    Comparing symbols through var also measures the type check and the infix
+    table lookup, so the ids are compared alone as well.
+*/
+int main() {
+
+    using namespace Oliver;
+    using namespace Oliver::bench;
+
+    constexpr std::size_t n      = 1000;
+    constexpr std::size_t rounds = 1000;
+
+    std::vector<std::string> names;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        names.push_back("environment_variable_" + std::to_string(i));
+    }
+
+    // Probe in a different order to the table, so that each is a fresh lookup.
+    std::vector<std::string> name_probes;
+    std::vector<var>         symbol_probes;
+    std::vector<symbol>      id_probes;
+    std::vector<var>         symbols;
+
+    const double interning = milliseconds([&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            symbols.emplace_back(symbol(names[i]));
+        }
+    });
+
+    for (std::size_t i = 0; i < n; ++i) {
+        name_probes.push_back(names[(i * 37) % n]);
+        symbol_probes.emplace_back(symbol(name_probes.back()));
+        id_probes.emplace_back(name_probes.back());
+    }
+
+    fmt::println("{:<24} {:>12} {:>10}", "operation", "ns each", "checksum");
+
+    auto report = [](std::string_view name, double ms, std::size_t operations, std::size_t checksum) {
+        fmt::println("{:<24} {:>12.2f} {:>10}", name, ms * 1e6 / operations, checksum);
+    };
+
+    report("intern a new name", interning, n, symbols.size());
+
+    std::size_t equal = 0;
+
+    const double string_equality = milliseconds([&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                equal += name_probes[i] == names[j];
+            }
+        }
+    });
+
+    report("string ==", string_equality, n * n, equal);
+
+    equal = 0;
+
+    const double symbol_equality = milliseconds([&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                equal += symbol_probes[i] == symbols[j];
+            }
+        }
+    });
+
+    report("symbol == through var", symbol_equality, n * n, equal);
+
+    equal = 0;
+
+    const double id_equality = milliseconds([&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                equal += id_probes[i].id() == id_probes[j].id();
+            }
+        }
+    });
+
+    report("symbol id ==", id_equality, n * n, equal);
+
+    std::unordered_map<std::string, std::size_t>           by_name;
+    std::unordered_map<symbol_table::id_type, std::size_t> by_id;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        by_name[names[i]]            = i;
+        by_id[symbol(names[i]).id()] = i;
+    }
+
+    std::size_t sum = 0;
+
+    const double name_lookup = milliseconds([&] {
+        for (std::size_t r = 0; r < rounds; ++r) {
+            for (const std::string& p : name_probes) {
+                sum += by_name.find(p)->second;
+            }
+        }
+    });
+
+    report("lookup by name", name_lookup, n * rounds, sum);
+
+    sum = 0;
+
+    const double id_lookup = milliseconds([&] {
+        for (std::size_t r = 0; r < rounds; ++r) {
+            for (const symbol& p : id_probes) {
+                sum += by_id.find(p.id())->second;
+            }
+        }
+    });
+
+    report("lookup by symbol id", id_lookup, n * rounds, sum);
+}
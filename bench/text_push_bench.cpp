@@ -0,0 +1,76 @@
+/********************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//          This program is free software : you can redistribute it and /or modify
+//          it under the terms of the GNU Affero General Public License as published by
+//          the Free Software Foundation, either version 3 of the License, or
+//          (at your option) any later version.
+//
+//          This program is distributed in the hope that it will be useful,
+//          but WITHOUT ANY WARRANTY; without even the implied warranty of
+//          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//          GNU Affero General Public License for more details.
+//
+//          You should have received a copy of the GNU Affero General Public License
+//          along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//          The author can be reached at: maxjmartin@gmail.com
+//
+/********************************************************************************************/
+
+#include <string>
+
+#include "oliver_lang.h"
+#include "benchmark.h"
+
+/*
+    Builds a 1 MiB text by pushing pieces of several sizes onto the front, and
+    counts the allocations made.  Each push joins onto the rope, so the time per
+    push should not grow with the length of the text.  Appending to a
+    'std::string', which is amortized O(1), is given for scale.
+*/
+int main() {
+
+    using namespace Oliver;
+    using namespace Oliver::bench;
+
+    constexpr std::size_t bytes = 1 << 20;
+
+    fmt::println("{:<8} {:>10} {:>10} {:>14} {:>14} {:>12}", "piece", "pushes", "ms", "ns per push", "string ns", "allocs/push");
+
+    for (std::size_t piece : { 1, 16, 256, 4096 }) {
+
+        const std::string value(piece, 'x');
+        const std::size_t pushes = bytes / piece;
+
+        const std::size_t before = allocations();
+
+        var result;
+
+        const double ms = milliseconds([&] {
+            var t{ text("") };
+
+            for (std::size_t i = 0; i < pushes; ++i) {
+                t = t.push(var(text(value)));
+            }
+            result = std::move(t);
+        });
+
+        const std::size_t count = allocations() - before;
+
+        std::string flat;
+
+        const double baseline = milliseconds([&] {
+            for (std::size_t i = 0; i < pushes; ++i) {
+                flat += value;
+            }
+        });
+
+        fmt::println("{:<8} {:>10} {:>10.1f} {:>14.1f} {:>14.1f} {:>12.2f}   (length {})",
+                     piece, pushes, ms, ms * 1e6 / pushes, baseline * 1e6 / pushes, double(count) / double(pushes), result.abs());
+    }
+}
@@ -0,0 +1,121 @@
+/********************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//          This program is free software : you can redistribute it and /or modify
+//          it under the terms of the GNU Affero General Public License as published by
+//          the Free Software Foundation, either version 3 of the License, or
+//          (at your option) any later version.
+//
+//          This program is distributed in the hope that it will be useful,
+//          but WITHOUT ANY WARRANTY; without even the implied warranty of
+//          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//          GNU Affero General Public License for more details.
+//
+//          You should have received a copy of the GNU Affero General Public License
+//          along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//          The author can be reached at: maxjmartin@gmail.com
+//
+/********************************************************************************************/
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "boost/container/flat_map.hpp"
+
+#include "oliver_lang.h"
+#include "benchmark.h"
+
+/*
+    The time to classify tokens as operators, and to name an operator code.
+    'find_operator' uses the perfect hash of 'operator_table', and is compared
+    with the sorted 'flat_map' of spellings that it replaced.  Two in three of
+    the tokens are operators, the rest are identifiers.
+*/
+int main() {
+
+    using namespace Oliver;
+    using namespace Oliver::bench;
+
+    constexpr std::size_t n = 1 << 20;
+
+    boost::container::flat_map<std::string, op_code> spellings;
+
+    for (const auto& [str, code] : operator_spellings) {
+        spellings.emplace(std::string(str), code);
+    }
+
+    std::mt19937 random(25);
+
+    std::vector<std::string> tokens;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        if (random() % 3) {
+            tokens.emplace_back(operator_spellings[random() % operator_spellings.size()].first);
+        }
+        else {
+            tokens.push_back("name_" + std::to_string(random() % 1000));
+        }
+    }
+
+    fmt::println("{} operators, in {} slots of {} buckets\n", operator_table::count, operator_table::slots, operator_table::buckets);
+    fmt::println("{:<28} {:>10} {:>14}", "operation", "ns each", "checksum");
+
+    std::size_t sum = 0;
+
+    const double map_find = milliseconds([&] {
+        for (const std::string& t : tokens) {
+            const auto it = spellings.find(t);
+            sum += it == spellings.end() ? 0 : static_cast<std::size_t>(it->second);
+        }
+    });
+
+    fmt::println("{:<28} {:>10.2f} {:>14}", "flat_map find", map_find * 1e6 / n, sum);
+
+    sum = 0;
+
+    const double hash_find = milliseconds([&] {
+        for (const std::string& t : tokens) {
+            sum += static_cast<std::size_t>(find_operator(t));
+        }
+    });
+
+    fmt::println("{:<28} {:>10.2f} {:>14}", "find_operator", hash_find * 1e6 / n, sum);
+
+    std::vector<op_code> codes;
+
+    for (const std::string& t : tokens) {
+        codes.push_back(find_operator(t));
+    }
+
+    // Naming a code from the map needs a scan of its values.
+    sum = 0;
+
+    const double map_name = milliseconds([&] {
+        for (op_code c : codes) {
+            for (const auto& [str, code] : spellings) {
+                if (code == c) {
+                    sum += str.size();
+                    break;
+                }
+            }
+        }
+    });
+
+    fmt::println("{:<28} {:>10.2f} {:>14}", "flat_map name scan", map_name * 1e6 / n, sum);
+
+    sum = 0;
+
+    const double array_name = milliseconds([&] {
+        for (op_code c : codes) {
+            sum += operator_name(c).size();
+        }
+    });
+
+    fmt::println("{:<28} {:>10.2f} {:>14}", "operator_name", array_name * 1e6 / n, sum);
+}
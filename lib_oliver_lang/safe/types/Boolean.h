@@ -25,6 +25,7 @@
 /*****************************************************************************************/
 
 #include <limits>
+#include <utility>
 
 #include "Var.h"
 
@@ -63,13 +64,37 @@ namespace Oliver {
         friend order        _comp_(const boolean& self, const var& other);
         friend std::string   _str_(const boolean& self, const Format_Args& fmt);
 
-        friend var           _and_(boolean& self, var& other);
-        friend var            _or_(boolean& self, var& other);
-        friend var           _xor_(boolean& self, var& other);
+        friend var           _and_(boolean& self, const var& other);
+        friend var            _or_(boolean& self, const var& other);
+        friend var           _xor_(boolean& self, const var& other);
+
+        friend order        _comp_(const boolean& self, const boolean& other);  // Typed kernels, used by the 'infix_table'.
+        friend var           _and_(const boolean& self, const boolean& other);
+        friend var            _or_(const boolean& self, const boolean& other);
+        friend var           _xor_(const boolean& self, const boolean& other);
         friend var           _neg_(boolean& self);
 
         void set_nan();
         void confirm_values();
+
+        friend class value;
+        friend struct interned<boolean>;
+    };
+
+    /*
+        Only the certain values, false and true, are interned.
+    */
+    template<>
+    struct interned<boolean> {
+        static constexpr std::size_t size = 2;
+
+        static std::size_t index(const boolean& x) noexcept {
+            return x._cert == 1.0 && (x._term == 0.0 || x._term == 1.0) ? static_cast<std::size_t>(x._term) : size;
+        }
+
+        static boolean value(std::size_t i) {
+            return boolean(i == 1);
+        }
     };
 
 
@@ -127,21 +152,25 @@ namespace Oliver {
         const boolean* b = other.cast<boolean>();
 
         if (b) {
+            return _comp_(self, *b);
+        }
+        return order::unordered;
+    }
 
-            bool p = _is_(self);
-            bool q = _is_(b);
+    order _comp_(const boolean& self, const boolean& other) {
 
-            if (p > q) {
-                return order::greater;
-            }
+        bool p = _is_(self);
+        bool q = _is_(other);
 
-            if (p < q) {
-                return order::less;
-            }
+        if (p > q) {
+            return order::greater;
+        }
 
-            return order::equivalent;
+        if (p < q) {
+            return order::less;
         }
-        return order::unordered;
+
+        return order::equivalent;
     }
 
     std::string _str_(const boolean& self, const Format_Args& fmt) {
@@ -153,75 +182,99 @@ namespace Oliver {
         return "false"s;
     }
 
-    var _and_(boolean& self, var& other) {
+    var _and_(boolean& self, const var& other) {
 
         const boolean* b = other.cast<boolean>();
 
         if (b) {
+            return _and_(std::as_const(self), *b);
+        }
 
-            self._term = std::fmin(self._term, b->_term);
-            self._cert = (self._cert + b->_cert) / 2.0;
+        boolean x = self;
+        x.set_nan();
+
+        return x;
+    }
 
-            return std::move(self);
+    var _or_(boolean& self, const var& other) {
+
+        const boolean* b = other.cast<boolean>();
+
+        if (b) {
+            return _or_(std::as_const(self), *b);
         }
 
-        self.set_nan();
+        boolean x = self;
+        x.set_nan();
 
-        return std::move(self);
+        return x;
     }
 
-    var _or_(boolean& self, var& other) {
+    var _xor_(boolean& self, const var& other) {
 
         const boolean* b = other.cast<boolean>();
 
         if (b) {
+            return _xor_(std::as_const(self), *b);
+        }
 
-            self._term = std::fmax(self._term, b->_term);
-            self._cert = (self._cert + b->_cert) / 2.0;
+        boolean x = self;
+        x.set_nan();
 
-            return std::move(self);
-        }
+        return x;
+    }
+
+    var _and_(const boolean& self, const boolean& other) {
 
-        self.set_nan();
+        boolean x = self;
 
-        return std::move(self);
+        x._term = std::fmin(self._term, other._term);
+        x._cert = (self._cert + other._cert) / 2.0;
+
+        return x;
     }
 
-    var _xor_(boolean& self, var& other) {
+    var _or_(const boolean& self, const boolean& other) {
 
-        const boolean* b = other.cast<boolean>();
+        boolean x = self;
 
-        if (b) {
-            auto x = self._term - self._cert;
-            auto y = b->_term - b->_cert;
+        x._term = std::fmax(self._term, other._term);
+        x._cert = (self._cert + other._cert) / 2.0;
+
+        return x;
+    }
+
+    var _xor_(const boolean& self, const boolean& other) {
 
-            self._term  = std::fmax(self._term, b->_term);
-            self._cert = (self._cert + b->_cert) / 2.0;
+        auto x = self._term - self._cert;
+        auto y = other._term - other._cert;
 
-            bool p = x < 0.0l;
-            bool q = y < 0.0l;
+        boolean z = self;
 
-            if (p ^ q) {
-                return std::move(self);
-            }
+        z._term = std::fmax(self._term, other._term);
+        z._cert = (self._cert + other._cert) / 2.0;
 
-            if (x + y) {
-                self._term = 1.0 - self._term;
-            }
+        bool p = x < 0.0l;
+        bool q = y < 0.0l;
 
-            return std::move(self);
+        if (p ^ q) {
+            return z;
         }
 
-        self.set_nan();
+        if (x + y) {
+            z._term = 1.0 - z._term;
+        }
 
-        return std::move(self);
+        return z;
     }
 
     var _neg_(boolean& self) {
 
-        self._term = 1.0 - self._term;
+        boolean x = self;
+
+        x._term = 1.0 - self._term;
 
-        return std::move(self);
+        return x;
     }
 
 }
\ No newline at end of file
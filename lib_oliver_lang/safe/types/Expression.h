@@ -27,6 +27,7 @@
 #include <tuple>
 
 #include "Var.h"
+#include "MemoryResource.h"
 #include "Number.h"
 
 namespace Oliver {
@@ -43,12 +44,17 @@ namespace Oliver {
 
     class expression {
 
-        std::vector<var> _expr;
+        std::pmr::vector<var> _expr;
 
     public:
 
         expression();
         expression(var x);
+        expression(const expression& other);
+        expression(expression&& other) noexcept = default;
+
+        expression& operator=(const expression& other) = default;
+        expression& operator=(expression&& other)      = default;
 
         friend std::string          _type_(const expression& self);
         friend std::size_t     _size_type_(const expression& self);
@@ -56,14 +62,22 @@ namespace Oliver {
         friend auto                 _comp_(const expression& self, const var& other);
 
         friend std::string           _str_(const expression& self, const Format_Args& fmt);
+        friend void                _write_(const expression& self, fmt::memory_buffer& out, const Format_Args& fmt);
 
-        friend var                  _lead_(expression& self);
-        friend var                  _push_(expression& self, var& other);
+        friend var                  _lead_(const expression& self);
+        friend var                  _push_(expression& self, const var& other);
+        friend var                  _push_(expression& self, var&& other);
         friend var                  _drop_(expression& self);
         friend var                 _shift_(expression& self);
         friend var               _reverse_(expression& self);
 
-        friend var                   _add_(expression& self, var& other);
+        friend var                   _add_(expression& self, const var& other);
+        friend var                   _add_(expression& self, var&& other);
+    };
+
+    template<>
+    struct shared_payload<expression> {
+        static constexpr bool value = true;
     };
 
     var make_pair(var a, var b);
@@ -75,13 +89,16 @@ namespace Oliver {
     //
     /********************************************************************************************/
 
-    expression::expression() : _expr() {
+    expression::expression() : _expr(current_resource()) {
     }
 
-    expression::expression(var x) : _expr() {
+    expression::expression(var x) : _expr(current_resource()) {
         _expr.push_back(x);
     }
 
+    expression::expression(const expression& other) : _expr(other._expr, current_resource()) {
+    }
+
     std::string _type_(const expression& self) {
         return "expression"s;
     }
@@ -110,39 +127,57 @@ namespace Oliver {
 
     std::string _str_(const expression& self, const Format_Args& fmt) {
 
-        if (!_is_(self)) {
-            return "()"s;
-        }
+        fmt::memory_buffer buffer;
 
-        std::string result = fmt::format("{}",self._expr.back().str(fmt));
+        _write_(self, buffer, fmt);
 
-        for (auto i = self._expr.crbegin() + 1; i != self._expr.crend(); ++i) {
-            result = fmt::format("{}, {}", result, i->str(fmt));
+        return fmt::to_string(buffer);
+    }
+
+    void _write_(const expression& self, fmt::memory_buffer& out, const Format_Args& fmt) {
+
+        out.push_back('(');
+
+        for (auto i = self._expr.crbegin(); i != self._expr.crend(); ++i) {
+
+            if (i != self._expr.crbegin()) {
+                out.push_back(',');
+                out.push_back(' ');
+            }
+
+            i->write(out, fmt);
         }
 
-        return fmt::format("({})", result);
+        out.push_back(')');
     }
 
-    var _lead_(expression& self) {
+    var _lead_(const expression& self) {
 
         if (!_is_(self)) {
             return var();
         }
 
-        var a(std::move(self._expr.back()));
-        self._expr.pop_back();
+        return self._expr.back();
+    }
 
-        return a;
+    var _push_(expression& self, const var& other) {
+
+        if (other.is_nothing()) {
+            return std::move(self);
+        }
+
+        self._expr.push_back(other);
+
+        return std::move(self);
     }
 
-    var _push_(expression& self, var& other) {
+    var _push_(expression& self, var&& other) {
 
         if (other.is_nothing()) {
             return std::move(self);
         }
 
         self._expr.push_back(std::move(other));
-        other = var();
 
         return std::move(self);
     }
@@ -160,6 +195,10 @@ namespace Oliver {
 
         var a = _lead_(self);
 
+        if (!self._expr.empty()) {
+            self._expr.pop_back();
+        }
+
         a = make_pair(a, self);
 
         return a;
@@ -176,9 +215,40 @@ namespace Oliver {
         return std::move(self);
     }
 
-    var _add_(expression& self, var& other) {
+    var _add_(expression& self, const var& other) {
+
+        const expression* ptr = other.cast<expression>();
+
+        if (ptr == &self) {  // Joined to itself, so the range inserted is not within the expression.
+
+            const std::size_t n = self._expr.size();
+
+            self._expr.reserve(2 * n);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                self._expr.push_back(self._expr[i]);
+            }
+
+            return std::move(self);
+        }
+
+        if (ptr) {
+
+            self._expr.insert(self._expr.begin(), ptr->_expr.begin(), ptr->_expr.end());
+
+            return std::move(self);
+        }
+
+        return var();
+    }
+
+    var _add_(expression& self, var&& other) {
+
+        if (other.cast<expression>() == &self) {
+            return _add_(self, other);  // Joined to itself, so it is not moved from.
+        }
 
-        if (other.type() == "expression") {
+        if (other.is<expression>()) {  // Splice onto the temporary expression, taking its buffer.
             auto ptr = other.move<expression>();
 
             ptr->_expr.insert(
@@ -207,7 +277,7 @@ namespace Oliver {
 
             var a = exp.lead();
 
-            if (a.type() != "expression") {
+            if (!a.is<expression>()) {
                 return expression(a);
             }
             exp = std::move(a);
@@ -24,8 +24,16 @@
 //
 /*****************************************************************************************/
 
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
 #include "Var.h"
+#include "Boolean.h"
+#include "MemoryResource.h"
 #include "Number.h"
+#include "../../unsafe/Simd.h"
 
 namespace Oliver {
 
@@ -36,16 +44,32 @@ namespace Oliver {
     //          The list class is implemented as a wrapper around a std::vector<var>.  
     //          The order of sequence for a list is reversed from that of a vector.   
     //
+    //          Adding two lists concatenates them.  'elementwise' instead applies an
+    //          operator to each pair of elements, or to each element and a scalar.
+    //          When every element is a real or an integer, the numbers are unboxed
+    //          into contiguous buffers and arithmetic and comparisons run through
+    //          the SIMD lane kernels.  Any other content falls back on a dispatch
+    //          per element, with the same results.
+    //
+    //          The elementary functions, 'exp', 'log', ... 'tanh', apply to each
+    //          element.  A list of reals and integers runs through the SIMD batch
+    //          kernels, which agree with the scalar functions to a few ulps.
+    //
     /********************************************************************************************/
 
     class list {
 
-        std::vector<var> _list;
+        std::pmr::vector<var> _list;
 
     public:
 
         list();
         list(var x);
+        list(const list& other);
+        list(list&& other) noexcept = default;
+
+        list& operator=(const list& other) = default;
+        list& operator=(list&& other)      = default;
 
         friend std::string          _type_(const list& self);
         friend std::size_t     _size_type_(const list& self);
@@ -53,14 +77,48 @@ namespace Oliver {
         friend auto                 _comp_(const list& self, const var& other);
 
         friend std::string           _str_(const list& self, const Format_Args& fmt);
+        friend void                _write_(const list& self, fmt::memory_buffer& out, const Format_Args& fmt);
 
-        friend var                  _lead_(list& self);
-        friend var                  _push_(list& self, var& other);
+        friend var                  _lead_(const list& self);
+        friend var                  _push_(list& self, const var& other);
+        friend var                  _push_(list& self, var&& other);
         friend var                  _drop_(list& self);
         friend var                 _shift_(list& self);
         friend var               _reverse_(list& self);
 
-        friend var                   _add_(list& self, var& other);
+        friend var                   _add_(list& self, const var& other);
+        friend var                   _add_(list& self, var&& other);
+
+        friend var           _elementwise_(list& self, op_code op, const var& other);
+
+        friend var                   _exp_(const list& self);
+        friend var                   _log_(const list& self);
+        friend var                   _sin_(const list& self);
+        friend var                   _cos_(const list& self);
+        friend var                   _tan_(const list& self);
+        friend var                  _sinh_(const list& self);
+        friend var                  _cosh_(const list& self);
+        friend var                  _tanh_(const list& self);
+
+    private:
+
+        struct lanes {  // The numbers of a list, unboxed.
+            std::vector<double>       reals;
+            std::vector<std::int64_t> integers;      // Filled while every number is an int32.
+            bool                      all_integers = true;
+            bool                      no_integers  = true;
+        };
+
+        static bool                  unbox(const var& x, lanes& out);  // Append a real or an integer.
+        static bool                  unbox(const list& self, lanes& out);
+        static std::optional<lane_op> lane(op_code op);
+        static var                   apply(op_code op, var a, const var& b);
+        static var                     map(const list& self, lane_fn fn, var (var::*scalar)());  // A new list, of each element mapped.
+    };
+
+    template<>
+    struct shared_payload<list> {
+        static constexpr bool value = true;
     };
 
     /********************************************************************************************/
@@ -69,13 +127,16 @@ namespace Oliver {
     //
     /********************************************************************************************/
 
-    list::list() : _list() {
+    list::list() : _list(current_resource()) {
     }
 
-    list::list(var x) : _list() {
+    list::list(var x) : _list(current_resource()) {
         _list.push_back(x);
     }
 
+    list::list(const list& other) : _list(other._list, current_resource()) {
+    }
+
     std::string _type_(const list& self) {
         return "list"s;
     }
@@ -104,20 +165,31 @@ namespace Oliver {
 
     std::string _str_(const list& self, const Format_Args& fmt) {
 
-        if (!_is_(self)) {
-            return "[]"s;
-        }
+        fmt::memory_buffer buffer;
 
-        std::string result = fmt::format("{}", self._list.back().str(fmt));
+        _write_(self, buffer, fmt);
 
-        for (auto i = self._list.crbegin() + 1; i != self._list.crend(); ++i) {
-            result = fmt::format("{}, {}", result, i->str(fmt));
+        return fmt::to_string(buffer);
+    }
+
+    void _write_(const list& self, fmt::memory_buffer& out, const Format_Args& fmt) {
+
+        out.push_back('[');
+
+        for (auto i = self._list.crbegin(); i != self._list.crend(); ++i) {
+
+            if (i != self._list.crbegin()) {
+                out.push_back(',');
+                out.push_back(' ');
+            }
+
+            i->write(out, fmt);
         }
 
-        return fmt::format("[{}]", result);
+        out.push_back(']');
     }
 
-    var _lead_(list& self) {
+    var _lead_(const list& self) {
 
         if (self._list.empty()) {
             return var();
@@ -125,7 +197,7 @@ namespace Oliver {
         return self._list.back();
     }
 
-    var _push_(list& self, var& other) {
+    var _push_(list& self, const var& other) {
 
         if (other.is_nothing()) {
             return std::move(self);
@@ -136,6 +208,17 @@ namespace Oliver {
         return std::move(self);
     }
 
+    var _push_(list& self, var&& other) {
+
+        if (other.is_nothing()) {
+            return std::move(self);
+        }
+
+        self._list.push_back(std::move(other));
+
+        return std::move(self);
+    }
+
     var _drop_(list& self) {
 
         if (!self._list.empty()) {
@@ -167,9 +250,40 @@ namespace Oliver {
         return std::move(self);
     }
 
-    var _add_(list& self, var& other) {
+    var _add_(list& self, const var& other) {
+
+        const list* ptr = other.cast<list>();
+
+        if (ptr == &self) {  // Joined to itself, so the range inserted is not within the list.
+
+            const std::size_t n = self._list.size();
+
+            self._list.reserve(2 * n);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                self._list.push_back(self._list[i]);
+            }
+
+            return std::move(self);
+        }
+
+        if (ptr) {
 
-        if (other.type() == "list") {
+            self._list.insert(self._list.begin(), ptr->_list.begin(), ptr->_list.end());
+
+            return std::move(self);
+        }
+
+        return var();
+    }
+
+    var _add_(list& self, var&& other) {
+
+        if (other.cast<list>() == &self) {
+            return _add_(self, other);  // Joined to itself, so it is not moved from.
+        }
+
+        if (other.is<list>()) {  // Splice onto the temporary list, taking its buffer.
             auto ptr = other.move<list>();
 
             ptr->_list.insert(
@@ -185,4 +299,245 @@ namespace Oliver {
 
         return var();
     }
-}
\ No newline at end of file
+
+    var _elementwise_(list& self, op_code op, const var& other) {
+
+        const list*       ptr = other.cast<list>();
+        const std::size_t n   = self._list.size();
+
+        if (ptr && ptr->_list.size() != n) {
+            return var();
+        }
+
+        if (auto kernel = list::lane(op)) {
+
+            list::lanes a;
+            list::lanes b;
+
+            bool unboxed = list::unbox(self, a);
+
+            if (unboxed && ptr) {
+                unboxed = list::unbox(*ptr, b);
+            }
+            else if (unboxed) {  // A scalar is broadcast to every lane.
+                unboxed = list::unbox(other, b);
+
+                if (unboxed) {
+                    b.reals.resize(n, b.reals.front());
+
+                    if (b.all_integers) {
+                        b.integers.resize(n, b.integers.front());
+                    }
+                }
+            }
+
+            const bool compare = *kernel >= lane_op::eq;
+
+            // Small integers give an exact integer result.
+            if (unboxed && !compare && a.all_integers && b.all_integers) {
+
+                std::vector<std::int64_t> result(n);
+
+                if (simd_apply(*kernel, a.integers.data(), b.integers.data(), result.data(), n)) {
+
+                    for (std::size_t i = 0; i < n; ++i) {
+                        self._list[i] = number(static_cast<long long>(result[i]));
+                    }
+                    return std::move(self);
+                }
+            }
+
+            // Otherwise each pair must hold a real, for a real result, as a number would give.
+            if (unboxed && (compare || a.no_integers || b.no_integers)) {
+
+                std::vector<double> result(n);
+
+                simd_apply(*kernel, a.reals.data(), b.reals.data(), result.data(), n);
+
+                for (std::size_t i = 0; i < n; ++i) {
+
+                    if (compare) {
+                        self._list[i] = boolean(result[i] != 0.0);
+                    }
+                    else {
+                        self._list[i] = number(std::complex<double>(result[i], 0.0));
+                    }
+                }
+                return std::move(self);
+            }
+        }
+
+        // Paired with itself, the right operand is the element, so it is copied rather than moved.
+        const bool aliased = ptr == &self;
+
+        for (std::size_t i = 0; i < n; ++i) {
+
+            const var& y = ptr ? ptr->_list[i] : other;
+
+            self._list[i] = aliased ? list::apply(op, self._list[i], y) : list::apply(op, std::move(self._list[i]), y);
+        }
+
+        return std::move(self);
+    }
+
+    var _exp_(const list& self) {
+        return list::map(self, lane_fn::exp, &var::exp);
+    }
+
+    var _log_(const list& self) {
+        return list::map(self, lane_fn::log, &var::log);
+    }
+
+    var _sin_(const list& self) {
+        return list::map(self, lane_fn::sin, &var::sin);
+    }
+
+    var _cos_(const list& self) {
+        return list::map(self, lane_fn::cos, &var::cos);
+    }
+
+    var _tan_(const list& self) {
+        return list::map(self, lane_fn::tan, &var::tan);
+    }
+
+    var _sinh_(const list& self) {
+        return list::map(self, lane_fn::sinh, &var::sinh);
+    }
+
+    var _cosh_(const list& self) {
+        return list::map(self, lane_fn::cosh, &var::cosh);
+    }
+
+    var _tanh_(const list& self) {
+        return list::map(self, lane_fn::tanh, &var::tanh);
+    }
+
+    bool list::unbox(const var& x, lanes& out) {
+
+        const number* ptr = x.cast<number>();
+
+        if (!ptr) {
+            return false;
+        }
+
+        if (auto i = std::get_if<number::int_type>(&ptr->_value)) {
+
+            // Only integers a double holds exactly.
+            if (*i < -(std::int64_t(1) << 53) || *i > (std::int64_t(1) << 53)) {
+                return false;
+            }
+
+            out.reals.push_back(static_cast<double>(*i));
+            out.no_integers = false;
+
+            if (out.all_integers && *i >= std::numeric_limits<std::int32_t>::min() && *i <= std::numeric_limits<std::int32_t>::max()) {
+                out.integers.push_back(*i);
+            }
+            else {
+                out.all_integers = false;
+            }
+            return true;
+        }
+
+        if (auto r = std::get_if<number::val_type>(&ptr->_value)) {
+            out.reals.push_back(*r);
+            out.all_integers = false;
+            return true;
+        }
+
+        return false;
+    }
+
+    bool list::unbox(const list& self, lanes& out) {
+
+        out.reals.reserve(self._list.size());
+
+        for (const var& x : self._list) {
+
+            if (!unbox(x, out)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    std::optional<lane_op> list::lane(op_code op) {
+
+        switch (op) {
+
+        case op_code::ADD_op: return lane_op::add;
+        case op_code::SUB_op: return lane_op::sub;
+        case op_code::MUL_op: return lane_op::mul;
+        case op_code::DIV_op: return lane_op::div;
+        case op_code::EQ_op:  return lane_op::eq;
+        case op_code::NE_op:  return lane_op::ne;
+        case op_code::LT_op:  return lane_op::lt;
+        case op_code::LE_op:  return lane_op::le;
+        case op_code::GT_op:  return lane_op::gt;
+        case op_code::GE_op:  return lane_op::ge;
+
+        default:
+            return std::nullopt;
+        }
+    }
+
+    /*
+        Only the logarithm has a restricted domain, a negative element gives
+        a complex result, so is left to the number.
+    */
+    var list::map(const list& self, lane_fn fn, var (var::*scalar)()) {
+
+        list::lanes a;
+        list        result;
+
+        result._list.reserve(self._list.size());
+
+        if (unbox(self, a) && (fn != lane_fn::log || std::none_of(a.reals.begin(), a.reals.end(), [](double x) { return x < 0; }))) {
+
+            const std::size_t n = self._list.size();
+
+            std::vector<double> reals(n);
+
+            simd_apply(fn, a.reals.data(), reals.data(), n);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                result._list.emplace_back(number(std::complex<double>(reals[i], 0.0)));
+            }
+            return result;
+        }
+
+        for (var x : self._list) {  // A copy, as 'self' may be shared.
+            result._list.emplace_back((x.*scalar)());
+        }
+
+        return result;
+    }
+
+    var list::apply(op_code op, var a, const var& b) {
+
+        switch (op) {
+
+        case op_code::ADD_op:  return a + b;
+        case op_code::SUB_op:  return a - b;
+        case op_code::MUL_op:  return a * b;
+        case op_code::DIV_op:  return a / b;
+        case op_code::MOD_op:  return a % b;
+        case op_code::FDIV_op: return a.f_div(b);
+        case op_code::REM_op:  return a.rem(b);
+        case op_code::EXP_op:  return a.pow(b);
+        case op_code::AND_op:  return a & b;
+        case op_code::OR_op:   return a | b;
+        case op_code::XOR_op:  return a ^ b;
+        case op_code::EQ_op:   return boolean(a == b);
+        case op_code::NE_op:   return boolean(!(a == b));
+        case op_code::LT_op:   return boolean(a <  b);
+        case op_code::LE_op:   return boolean(a <= b);
+        case op_code::GT_op:   return boolean(a >  b);
+        case op_code::GE_op:   return boolean(a >= b);
+
+        default:
+            return var();
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+/*****************************************************************************************/
+//
+//                           Copyright(C) 2023 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter. 
+//    
+//        This program is free software : you can redistribute it and /or modify
+//        it under the terms of the GNU Affero General Public License as published by
+//        the Free Software Foundation, either version 3 of the License, or
+//        (at your option) any later version.
+//    
+//        This program is distributed in the hope that it will be useful,
+//        but WITHOUT ANY WARRANTY; without even the implied warranty of
+//        MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//        GNU Affero General Public License for more details.
+//    
+//        You should have received a copy of the GNU Affero General Public License
+//        along with this program.If not, see <https://www.gnu.org/licenses/>.
+//    
+//        The author can be reached at: maxjmartin@gmail.com
+//
+/*****************************************************************************************/
+
+#include <memory_resource>
+
+namespace Oliver {
+
+    /********************************************************************************************/
+    //
+    //                             'Memory Resource' Definitions
+    //
+    //          The containers wrapped by 'list', 'expression', 'object' and 'text' take
+    //          their memory from the current thread's memory resource.  By default this
+    //          is 'std::pmr::get_default_resource()'.  A 'scoped_resource' replaces it
+    //          for its lifetime, so a request, (or an interpreter), may be run on its
+    //          own heap, such as a 'std::pmr::monotonic_buffer_resource', and then
+    //          dropped wholesale.
+    //              Example:  std::pmr::monotonic_buffer_resource buffer;
+    //                        {
+    //                            scoped_resource scope(&buffer);
+    //                            var result = evaluate(code);
+    //                            ...
+    //                        }
+    //
+    //          Containers keep the resource they were constructed with, and copies are
+    //          made using the resource current at the time of the copy.  So any var
+    //          built within a scope must be destroyed, (or copied out), before the
+    //          resource it allocated from is released.
+    //
+    /********************************************************************************************/
+
+    std::pmr::memory_resource* current_resource() noexcept;
+
+    class scoped_resource {
+
+    public:
+
+        explicit scoped_resource(std::pmr::memory_resource* resource) noexcept;
+        ~scoped_resource()                                            noexcept;
+
+        scoped_resource(const scoped_resource&)            = delete;
+        scoped_resource& operator=(const scoped_resource&) = delete;
+
+    private:
+
+        std::pmr::memory_resource* _prev;
+
+        static inline thread_local std::pmr::memory_resource* _current = nullptr;
+
+        friend std::pmr::memory_resource* current_resource() noexcept;
+    };
+
+    /********************************************************************************************/
+    //
+    //                            'Memory Resource' Implementation
+    //
+    /********************************************************************************************/
+
+    inline std::pmr::memory_resource* current_resource() noexcept {
+        auto resource = scoped_resource::_current;
+        return resource ? resource : std::pmr::get_default_resource();
+    }
+
+    inline scoped_resource::scoped_resource(std::pmr::memory_resource* resource) noexcept : _prev(_current) {
+        _current = resource;
+    }
+
+    inline scoped_resource::~scoped_resource() noexcept {
+        _current = _prev;
+    }
+}
@@ -0,0 +1,449 @@
+#pragma once
+
+/*****************************************************************************************/
+//
+//                           Copyright(C) 2023 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter. 
+//    
+//        This program is free software : you can redistribute it and /or modify
+//        it under the terms of the GNU Affero General Public License as published by
+//        the Free Software Foundation, either version 3 of the License, or
+//        (at your option) any later version.
+//    
+//        This program is distributed in the hope that it will be useful,
+//        but WITHOUT ANY WARRANTY; without even the implied warranty of
+//        MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//        GNU Affero General Public License for more details.
+//    
+//        You should have received a copy of the GNU Affero General Public License
+//        along with this program.If not, see <https://www.gnu.org/licenses/>.
+//    
+//        The author can be reached at: maxjmartin@gmail.com
+//
+/*****************************************************************************************/
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace Oliver {
+
+    class node_arena;
+
+    /********************************************************************************************/
+    //
+    //                                'node_pool' Class Definition
+    //
+    //          The node_pool class serves the heap allocated 'var::data_type<T>' nodes.
+    //          Requests are rounded up to a size class, and taken from a per-thread free
+    //          list of that class.  When a free list runs dry it is refilled by carving
+    //          a 64 KiB slab into nodes.  Slabs are never returned to the system, they
+    //          are retained and reused for the life of the program.
+    //
+    //          Requests larger than the largest size class go straight to the global heap.
+    //
+    //          While a 'node_arena' is active on a thread, that thread's nodes are taken
+    //          from the arena instead.
+    //
+    //          The hits and misses are counted per thread, without a locked instruction,
+    //          and 'stats' sums the counts of every thread.
+    //
+    /********************************************************************************************/
+
+    class node_pool {
+
+    public:
+
+        struct statistics {
+            std::uint64_t hits;             // Requests served without carving a new slab.
+            std::uint64_t misses;           // Requests which needed a new slab, or the global heap.
+            std::uint64_t bytes_retained;   // Bytes held in slabs and arena chunks.
+        };
+
+        static constexpr std::size_t granularity = alignof(std::max_align_t);
+        static constexpr std::size_t max_size    = 256;
+        static constexpr std::size_t chunk_size  = 64 * 1024;
+
+        static void*          allocate(std::size_t size);
+        static void         deallocate(void* ptr, std::size_t size) noexcept;
+        static statistics        stats()                            noexcept;
+
+    private:
+
+        friend class node_arena;
+
+        struct free_node {
+            free_node* next;
+        };
+
+        struct chunk_header {
+            node_arena*   arena;  // The owning arena, or null for a pool slab.
+            chunk_header* next;
+        };
+
+        static constexpr std::size_t class_count = max_size / granularity;
+        static constexpr std::size_t header_size = (sizeof(chunk_header) + granularity - 1) / granularity * granularity;
+
+        using free_lists = std::array<free_node*, class_count>;
+
+        struct thread_cache {
+            free_lists free{};
+
+            thread_cache() noexcept;
+            ~thread_cache();
+        };
+
+        struct thread_counts {                      // Zero initialized, as it is only held in thread storage.
+            std::atomic<std::uint64_t> hits;        // Only written by the owning thread.
+            std::atomic<std::uint64_t> misses;
+            thread_counts*             next;
+        };
+
+        enum class cache_state : std::uint8_t { unborn, alive, dead };
+
+        static inline std::mutex    _mutex;
+        static inline free_lists    _free{};            // Nodes given back by exiting threads.
+        static inline chunk_header* _spare = nullptr;   // Chunks released by arenas.
+
+        static inline std::atomic<std::uint64_t> _hits{0};              // Counts of the threads which have exited.
+        static inline std::atomic<std::uint64_t> _misses{0};
+        static inline std::atomic<std::uint64_t> _retained{0};
+        static inline thread_counts*             _threads = nullptr;    // Counts of the live threads.
+
+        static inline thread_local cache_state   _cache_state = cache_state::unborn;
+        static inline thread_local node_arena*   _arena       = nullptr;
+        static inline thread_local thread_counts _counts;
+
+        static thread_cache&        cache();
+        static void                 count(std::atomic<std::uint64_t>& mine, std::atomic<std::uint64_t>& exited) noexcept;
+        static void             count_hit() noexcept;
+        static void            count_miss() noexcept;
+        static std::size_t      class_of(std::size_t size) noexcept;
+        static chunk_header*   new_chunk(node_arena* owner);
+        static void               refill(free_lists& free, std::size_t k);
+        static chunk_header*  chunk_of(void* ptr) noexcept;
+    };
+
+    /********************************************************************************************/
+    //
+    //                                'node_arena' Class Definition
+    //
+    //          A node_arena is a scoped, bump allocated, region for the nodes created on
+    //          the current thread while it is alive.  Freeing a node within the arena
+    //          does nothing, the whole of the arena's memory is released at once when
+    //          it goes out of scope.  Arenas nest, the innermost one is used.
+    //
+    //          Every var allocated within an arena must be destroyed before the arena,
+    //          such as the temporaries of a single evaluation.  Even a copy made in the
+    //          scope is taken from the arena, so a result which is to outlive it must
+    //          leave as something other than a heap allocated var, such as a string.
+    //
+    //          The arena counts its live nodes, from whichever thread frees them.  A
+    //          node still live when the arena is destroyed terminates the program, in
+    //          every build, as its chunk would otherwise be reused beneath it.
+    //
+    //              Example:  {
+    //                            node_arena scope;
+    //                            var result = evaluate(code);
+    //                            ...
+    //                        }
+    //
+    /********************************************************************************************/
+
+    class node_arena {
+
+    public:
+
+        node_arena();
+        ~node_arena();
+
+        node_arena(const node_arena&)            = delete;
+        node_arena& operator=(const node_arena&) = delete;
+
+    private:
+
+        friend class node_pool;
+
+        node_arena*               _prev   = nullptr;
+        node_pool::chunk_header*  _chunks = nullptr;
+        std::byte*                _next   = nullptr;
+        std::byte*                _end    = nullptr;
+        std::atomic<std::size_t>  _live   = 0;  // Nodes allocated and not yet freed.
+
+        void* allocate(std::size_t size);
+    };
+
+    /********************************************************************************************/
+    //
+    //                                'node_pool' Class Implementation
+    //
+    /********************************************************************************************/
+
+    inline void* node_pool::allocate(std::size_t size) {
+
+        if (size > max_size) {
+            count_miss();
+            return ::operator new(size);
+        }
+
+        const std::size_t k = class_of(size);
+
+        if (_arena) {
+            return _arena->allocate((k + 1) * granularity);
+        }
+
+        auto& free = cache().free;
+
+        if (free[k]) {
+            count_hit();
+        }
+        else {
+            refill(free, k);
+        }
+
+        free_node* node = free[k];
+        free[k] = node->next;
+        return node;
+    }
+
+    inline void node_pool::deallocate(void* ptr, std::size_t size) noexcept {
+
+        if (!ptr) {
+            return;
+        }
+
+        if (size > max_size) {
+            ::operator delete(ptr, size);
+            return;
+        }
+
+        chunk_header* chunk = chunk_of(ptr);
+
+        if (chunk->arena) {
+            chunk->arena->_live.fetch_sub(1, std::memory_order_release);
+            return;
+        }
+
+        const std::size_t k = class_of(size);
+        auto node = static_cast<free_node*>(ptr);
+
+        if (_cache_state != cache_state::dead) {
+            auto& free = cache().free;
+            node->next = free[k];
+            free[k] = node;
+        }
+        else {
+            std::lock_guard lock(_mutex);
+            node->next = _free[k];
+            _free[k] = node;
+        }
+    }
+
+    inline node_pool::statistics node_pool::stats() noexcept {
+
+        std::lock_guard lock(_mutex);
+
+        statistics result{
+            _hits.load(std::memory_order_relaxed),
+            _misses.load(std::memory_order_relaxed),
+            _retained.load(std::memory_order_relaxed)
+        };
+
+        for (auto c = _threads; c; c = c->next) {
+            result.hits   += c->hits.load(std::memory_order_relaxed);
+            result.misses += c->misses.load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    inline node_pool::thread_cache::thread_cache() noexcept {
+
+        std::lock_guard lock(_mutex);
+
+        _counts.next = _threads;
+        _threads     = &_counts;
+
+        _cache_state = cache_state::alive;
+    }
+
+    inline node_pool::thread_cache::~thread_cache() {
+
+        std::lock_guard lock(_mutex);
+
+        // Keep the counts of this thread, once it has exited.
+        for (auto p = &_threads; *p; p = &(*p)->next) {
+
+            if (*p == &_counts) {
+                *p = _counts.next;
+                break;
+            }
+        }
+
+        _hits.fetch_add(_counts.hits.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        _misses.fetch_add(_counts.misses.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+        // Give the free nodes back, so another thread may reuse them.
+
+        for (std::size_t k = 0; k < class_count; ++k) {
+
+            while (free[k]) {
+                free_node* node = free[k];
+                free[k] = node->next;
+                node->next = _free[k];
+                _free[k] = node;
+            }
+        }
+        _cache_state = cache_state::dead;
+    }
+
+    inline node_pool::thread_cache& node_pool::cache() {
+        static thread_local thread_cache local;
+        return local;
+    }
+
+    /*
+        Only the owning thread writes its counts, so an increment is a plain load
+        and store, which 'stats' may read at any time.  A thread's counts are
+        registered with its cache, and once the cache is gone they are counted
+        with those of the exited threads.
+    */
+    inline void node_pool::count(std::atomic<std::uint64_t>& mine, std::atomic<std::uint64_t>& exited) noexcept {
+
+        if (_cache_state == cache_state::unborn) {
+            cache();
+        }
+
+        if (_cache_state == cache_state::alive) {
+            mine.store(mine.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+        else {
+            exited.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    inline void node_pool::count_hit() noexcept {
+        count(_counts.hits, _hits);
+    }
+
+    inline void node_pool::count_miss() noexcept {
+        count(_counts.misses, _misses);
+    }
+
+    inline std::size_t node_pool::class_of(std::size_t size) noexcept {
+        return size ? (size - 1) / granularity : 0;
+    }
+
+    inline node_pool::chunk_header* node_pool::new_chunk(node_arena* owner) {
+
+        chunk_header* chunk = nullptr;
+        {
+            std::lock_guard lock(_mutex);
+
+            if (_spare) {
+                chunk = _spare;
+                _spare = chunk->next;
+            }
+        }
+
+        if (!chunk) {
+            chunk = static_cast<chunk_header*>(::operator new(chunk_size, std::align_val_t(chunk_size)));
+            _retained.fetch_add(chunk_size, std::memory_order_relaxed);
+        }
+
+        chunk->arena = owner;
+        chunk->next  = nullptr;
+        return chunk;
+    }
+
+    inline void node_pool::refill(free_lists& free, std::size_t k) {
+        {
+            std::lock_guard lock(_mutex);
+
+            if (_free[k]) {
+                free[k] = std::exchange(_free[k], nullptr);
+                count_hit();
+                return;
+            }
+        }
+
+        count_miss();
+
+        const std::size_t node_size = (k + 1) * granularity;
+
+        auto base = reinterpret_cast<std::byte*>(new_chunk(nullptr));
+
+        for (std::size_t i = (chunk_size - header_size) / node_size; i > 0; --i) {
+            free[k] = ::new (static_cast<void*>(base + header_size + (i - 1) * node_size)) free_node{ free[k] };
+        }
+    }
+
+    inline node_pool::chunk_header* node_pool::chunk_of(void* ptr) noexcept {
+        return reinterpret_cast<chunk_header*>(reinterpret_cast<std::uintptr_t>(ptr) & ~(std::uintptr_t(chunk_size) - 1));
+    }
+
+    /********************************************************************************************/
+    //
+    //                                'node_arena' Class Implementation
+    //
+    /********************************************************************************************/
+
+    inline node_arena::node_arena() : _prev(node_pool::_arena) {
+        node_pool::_arena = this;
+    }
+
+    inline node_arena::~node_arena() {
+
+        if (_live.load(std::memory_order_acquire) != 0) {
+            std::fputs("A var allocated within a node_arena outlived it.\n", stderr);
+            std::terminate();
+        }
+
+        node_pool::_arena = _prev;
+
+        if (!_chunks) {
+            return;
+        }
+
+        node_pool::chunk_header* last = _chunks;
+
+        for (auto chunk = _chunks; chunk; chunk = chunk->next) {
+            chunk->arena = nullptr;
+            last = chunk;
+        }
+
+        std::lock_guard lock(node_pool::_mutex);
+        last->next = node_pool::_spare;
+        node_pool::_spare = _chunks;
+    }
+
+    inline void* node_arena::allocate(std::size_t size) {
+
+        if (static_cast<std::size_t>(_end - _next) < size) {
+
+            node_pool::count_miss();
+
+            auto chunk = node_pool::new_chunk(this);
+            chunk->next = _chunks;
+            _chunks = chunk;
+
+            _next = reinterpret_cast<std::byte*>(chunk) + node_pool::header_size;
+            _end  = reinterpret_cast<std::byte*>(chunk) + node_pool::chunk_size;
+        }
+        else {
+            node_pool::count_hit();
+        }
+
+        void* ptr = _next;
+        _next += size;
+        _live.fetch_add(1, std::memory_order_relaxed);
+        return ptr;
+    }
+}
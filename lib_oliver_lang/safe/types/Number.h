@@ -24,11 +24,29 @@
 //
 /*****************************************************************************************/
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
 #include <complex>
-#include <vector>
+#include <cstdint>
+#include <ios>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+#include <boost/multiprecision/cpp_bin_float.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
 
 #include "Var.h"
 #include "../../toolbox/text_support.h"
+#include "../../unsafe/Big_Arithmetic.h"
 
 namespace Oliver {
 
@@ -36,301 +54,2449 @@ namespace Oliver {
     //
     //                                 'number' class
     //
-    //        The number class implements a mathematical number using the C++ 'complex'
-    //        number type.   
+    //        The number class implements a mathematical number, using a tagged
+    //        representation.  Integers are held as a machine 'int64', and other real
+    //        values as a 'double'.  These are the fast path for nearly all arithmetic.
+    //        Only a value with an imaginary part is held as a C++ 'complex' double,
+    //        and complex arithmetic is only used when one is present.
     //
-    //        TODO: re-implement the class using arbitrary arithmetic.
+    //        Integer arithmetic which overflows is promoted to an arbitrary precision
+    //        Boost.Multiprecision integer, and is demoted again when the result fits.
+    //        An exact rational is selected by writing a literal as a fraction, '1/3'.
+    //        It is held as an 'int64' pair in lowest terms, promoted to a big rational
+    //        on overflow.  Arithmetic between rationals and integers stays exact.
+    //        A decimal is selected by a 'd' suffix, '19.99d'.  It is a scaled 'int64',
+    //        so base ten fractions are exact, and it is written back as it was read.
+    //        Real literals written with more significant digits than a double holds
+    //        request a 50 digit Boost.Multiprecision float instead.
+    //
+    //        The arbitrary precision values are immutable, and shared between copies.
     //
     /********************************************************************************************/
 
     class number {
-        typedef		double		                val_type;
-        typedef		std::complex<double>		num_type;
+        typedef		std::int64_t		                        int_type;
+        typedef		double		                                val_type;
+        typedef		std::complex<double>		                num_type;
+        typedef     boost::multiprecision::cpp_int              big_int;
+        typedef     boost::multiprecision::cpp_bin_float_50     big_float;
+        typedef     boost::multiprecision::cpp_rational         big_rational;
 
-    public:
+        struct ratio_type {  // In lowest terms, with a denominator greater than one.
+            int_type num;
+            int_type den;
+        };
+
+        struct decimal_type {  // The value 'coef * 10^-scale'.
+            int_type     coef;
+            std::uint8_t scale;
+        };
+
+        typedef     std::variant<int_type, val_type, num_type, std::shared_ptr<const big_int>, std::shared_ptr<const big_float>,
+                                 ratio_type, std::shared_ptr<const big_rational>, decimal_type> rep_type;
 
-        // typedef     boost::multiprecision::cpp_complex<0> test_type;
+        enum kind : std::uint8_t {  // In the order of 'rep_type'.
+            integer_kind, real_kind, complex_kind, big_int_kind, big_float_kind, rational_kind, big_rational_kind, decimal_kind
+        };
+
+        static constexpr std::uint8_t max_scale = 18;  // The largest power of ten in an 'int64'.
+
+    public:
 
         number();
-        number(std::string str);
+        number(std::string_view str);
         number(long long value);
         number(const num_type& value);
 
         friend std::string       _type_(const number& self);
         friend bool         _is_(const number& self);
-        friend order    _comp_(const number& self, const var other);
+        friend std::int64_t _integer_type_(const number& self);  // Truncated, and saturated to the int64 range.
+        friend order    _comp_(const number& self, const var& other);
         friend std::string _str_(const number& self, const Format_Args& fmt);
+        friend void      _write_(const number& self, fmt::memory_buffer& out, const Format_Args& fmt);
 
-        friend var         _add_(number& self, var other);
-        friend var         _sub_(number& self, var other);
-        friend var         _mul_(number& self, var other);
-        friend var         _div_(number& self, var other);
-        friend var         _mod_(number& self, var other);
+        friend var         _add_(number& self, const var& other);
+        friend var         _sub_(number& self, const var& other);
+        friend var         _mul_(number& self, const var& other);
+        friend var         _div_(number& self, const var& other);
+        friend var         _mod_(number& self, const var& other);
         friend var         _neg_(number& self);
 
-        friend var       _f_div_(const number& self, var other);
-        friend var         _rem_(const number& self, var other);
-        friend var         _pow_(const number& self, var other);
+        friend var       _f_div_(number& self, const var& other);
+        friend var         _rem_(number& self, const var& other);
+        friend var         _pow_(number& self, const var& other);
+
+        friend order    _comp_(const number& self, const number& other);  // Typed kernels, used by the 'infix_table'.
+        friend var         _add_(const number& self, const number& other);
+        friend var         _sub_(const number& self, const number& other);
+        friend var         _mul_(const number& self, const number& other);
+        friend var         _div_(const number& self, const number& other);
+        friend var         _mod_(const number& self, const number& other);
+        friend var       _f_div_(const number& self, const number& other);
+        friend var         _rem_(const number& self, const number& other);
+        friend var         _pow_(const number& self, const number& other);
+
+        friend var        _root_(const number& self, const var& other);
+        friend var        _real_(const number& self);
+        friend var        _imag_(const number& self);
+        friend var         _abs_(const number& self);
+
+        friend var         _exp_(const number& self);
+        friend var         _log_(const number& self);
+        friend var         _sin_(const number& self);
+        friend var         _cos_(const number& self);
+        friend var         _tan_(const number& self);
+        friend var        _sinh_(const number& self);
+        friend var        _cosh_(const number& self);
+        friend var        _tanh_(const number& self);
+
+        friend class value;
+        friend class list;  // To unbox its numbers for the SIMD kernels.
+        friend struct interned<number>;
 
     private:
 
-        num_type _value;
+        rep_type _value;
+
+        number(big_int value);
+        number(big_float value);
+        number(ratio_type value);
+        number(big_rational value);
+        number(decimal_type value);
+
+        kind               type()      const;
+        bool             is_nan()      const;
+        bool        is_negative()      const;  // Is the number less than zero?  A complex never is.
+        bool        is_integral()      const;  // Is the number an int64, or a big integer?
+        int_type        integer()      const;  // The int64 of an 'integer_kind'.
+        val_type        to_real()      const;  // The real part, as a double.
+        num_type     to_complex()      const;
+        big_int      to_big_int()      const;  // Only valid when 'is_integral()'.
+        big_float  to_big_float()      const;
+        bool           is_exact()      const;  // Is the number an integer, a rational, or a decimal?
+        ratio_type     as_ratio()      const;  // Only valid for an 'integer_kind' or a 'rational_kind'.
+        decimal_type as_decimal()      const;  // Only valid for an 'integer_kind' or a 'decimal_kind'.
+        big_rational to_big_rational() const;  // Only valid when 'is_exact()'.
+
+        static number   normalize(big_int x);  // Demote a big integer to an int64, when it fits.
+        static number   normalize(big_rational x);
+        static kind   common_kind(const number& a, const number& b);
+
+        static number            make_ratio(int_type num, int_type den);  // Reduce to lowest terms, 'den' is not zero.
+        static std::uint64_t            gcd(std::uint64_t a, std::uint64_t b);
+        static std::optional<number> add_ratio(ratio_type x, ratio_type y);
+        static std::optional<number> mul_ratio(ratio_type x, ratio_type y);
+
+        static int_type                   pow10(std::uint8_t n);  // For 'n' no greater than 'max_scale'.
+        static bool                       align(decimal_type& x, decimal_type& y);  // Rescale to the larger scale.
+
+        enum rounding : bool { truncate, floor };
+
+        static number          divide_exact(const number& a, const number& b, rounding mode, bool remainder);
+
+        static bool  add_overflow(int_type a, int_type b, int_type& r);
+        static bool  sub_overflow(int_type a, int_type b, int_type& r);
+        static bool  mul_overflow(int_type a, int_type b, int_type& r);
+
+        static number         nan();
+        static number   from_real(val_type x);
+
+        template<typename F>
+        static number  elementary(const number& x, F f);  // Apply 'f' to the double, complex, or big float of 'x'.
+
+        bool                           parse(std::string_view str);
+        bool                     parse_ratio(rep_type num, const char* first, const char* last);
+        bool                   parse_decimal(std::string_view str);
+        static const char*     parse_literal(const char* first, const char* last, rep_type& x);
+        static std::size_t significant_digits(const char* first, const char* last);
+        static bool       starts_with_no_case(std::string_view str, std::string_view lower);
+        static std::string_view          trim(std::string_view str);
+        static const char*   skip_white_space(const char* first, const char* last);
+        static val_type               as_real(const rep_type& x);
+
+        static std::size_t      write_sign(fmt::memory_buffer& out, bool negative, const Format_Args& fmt);
+        static std::size_t   write_integer(fmt::memory_buffer& out, int_type x, const Format_Args& fmt);
+        static std::size_t      write_real(fmt::memory_buffer& out, val_type x, const Format_Args& fmt);
+        static std::size_t       write_big(const number& self, fmt::memory_buffer& out, const Format_Args& fmt);
+        static std::size_t     write_ratio(const number& self, fmt::memory_buffer& out, const Format_Args& fmt);
+        static std::size_t   write_decimal(fmt::memory_buffer& out, decimal_type x, const Format_Args& fmt);
+        static void                    pad(fmt::memory_buffer& out, std::size_t start, std::size_t digits, const Format_Args& fmt);
+    };
+
+    /*
+        The small integers used for counting and indexing, followed by NaN and
+        positive and negative infinity.  Every NaN shares the one quiet NaN.
+    */
+    template<>
+    struct interned<number> {
+        static constexpr number::int_type least = -128;
+        static constexpr number::int_type most  = 1023;
+
+        static constexpr std::size_t integers = most - least + 1;
+        static constexpr std::size_t size     = integers + 3;
+
+        static std::size_t index(const number& x) noexcept {
+
+            if (const auto i = std::get_if<number::int_type>(&x._value)) {
+                return least <= *i && *i <= most ? static_cast<std::size_t>(*i - least) : size;
+            }
+
+            if (const auto r = std::get_if<number::val_type>(&x._value)) {
+
+                if (std::isnan(*r)) {
+                    return integers;
+                }
+
+                if (std::isinf(*r)) {
+                    return *r > 0 ? integers + 1 : integers + 2;
+                }
+            }
+
+            return size;
+        }
+
+        static number value(std::size_t i) {
+
+            if (i < integers) {
+                return number(static_cast<long long>(static_cast<number::int_type>(i) + least));
+            }
+
+            if (i == integers) {
+                return number::nan();
+            }
 
-        bool is_nan() const;
+            return number::from_real(i == integers + 1 ? std::numeric_limits<number::val_type>::infinity()
+                                                       : -std::numeric_limits<number::val_type>::infinity());
+        }
     };
 
-    number::number() : _value(0.0, 0.0) {
+    number::number() : _value(int_type(0)) {
     }
 
-    number::number(std::string str) : _value(0.0, 0.0) {
+    number::number(std::string_view str) : _value(int_type(0)) {
+
+        str = trim(str);
 
-        if (str == "") {
+        if (str.empty()) {
             return;
         }
 
-        str = to_lower_case(str);
-
-        if (str == "nan") {
-            _value = num_type(std::numeric_limits<val_type>::quiet_NaN(), std::numeric_limits<val_type>::quiet_NaN());
-            return;
+        if (!parse(str)) {
+            _value = std::numeric_limits<val_type>::quiet_NaN();
         }
+    }
 
-        if (str == "inf" || str == "+inf") {
-            _value = num_type(std::numeric_limits<val_type>::infinity(), std::numeric_limits<val_type>::infinity());
-            return;
+    /*
+        The literal parser makes a single pass over the text, with no heap
+        allocation unless a literal is too large for an int64 or a double.
+        It accepts, (ignoring case and surrounding white space):
+            integers and reals          42, -7, 2.5, 1e-3
+            nan and infinities          nan, inf, +inf, -infinity
+            imaginary numbers           3j, -2.5i
+            complex numbers             1+2j, 1 - 2j, (1,2j), (1, -2j), (1,2)
+            exact rationals             1/3, -22/7
+            exact decimals              19.99d, -0.001d, 42d
+        Anything else is not a number, and parses as nan.
+    */
+    bool number::parse(std::string_view str) {
+
+        if (str.back() == 'd' || str.back() == 'D') {
+            return parse_decimal(trim(str.substr(0, str.size() - 1)));
         }
 
-        if (str == "-inf") {
-            _value = num_type(std::numeric_limits<val_type>::infinity(), std::numeric_limits<val_type>::infinity());
-            return;
+        if (str.front() == '(') {
+
+            if (str.back() != ')') {
+                return false;
+            }
+            str = trim(str.substr(1, str.size() - 2));
         }
 
-        str = to_white_space(str, ",()");
+        const char* last = str.data() + str.size();
+
+        rep_type real;
 
-        std::vector<std::string> tokens = split(str, " ");
+        const char* p = parse_literal(str.data(), last, real);
 
-        val_type real = 0;
-        val_type imag = 0;
+        if (!p) {
+            return false;
+        }
 
-        if (tokens.size()) {
+        p = skip_white_space(p, last);
 
-            if (tokens.back().back() == 'i' || tokens.back().back() == 'j' || tokens.size() > 1) {
+        if (p == last) {
+            _value = std::move(real);
+            return true;
+        }
 
-                std::string t = tokens.back();
-                t.pop_back();
+        if (*p == '/') {
+            return parse_ratio(std::move(real), skip_white_space(p + 1, last), last);
+        }
 
-                imag = to<val_type>(t).value_or(0);
+        if (*p == 'i' || *p == 'j' || *p == 'I' || *p == 'J') {
 
-                tokens.pop_back();
+            if (skip_white_space(p + 1, last) != last) {
+                return false;
             }
+
+            *this = number(num_type(0.0, as_real(real)));
+            return true;
         }
 
-        if (tokens.size() > 1) {
+        const bool pair = *p == ',';  // The '(re,im)' form, where the 'j' is optional.
 
-            if (tokens.back() == "-") {
-                imag = -imag;
-            }
+        if (pair) {
+            p = skip_white_space(p + 1, last);
+        }
 
-            else if (tokens.back() != "+") {
-                _value = num_type(std::numeric_limits<val_type>::quiet_NaN(), std::numeric_limits<val_type>::quiet_NaN());
-                return;
-            }
+        bool negative = false;
+
+        if (p != last && (*p == '+' || *p == '-')) {
+            negative = *p == '-';
+            p = skip_white_space(p + 1, last);
         }
 
-        if (tokens.size()) {
+        rep_type imag;
+
+        p = parse_literal(p, last, imag);
 
-            real = to<val_type>(tokens.front()).value_or(0);
+        if (!p) {
+            return false;
         }
 
-        _value = num_type(real, imag);
-    }
+        if (p != last && (*p == 'i' || *p == 'j' || *p == 'I' || *p == 'J')) {
+            ++p;
+        }
+        else if (!pair) {
+            return false;
+        }
 
-    number::number(long long value) : _value(static_cast<val_type>(value)) {
-    }
+        if (skip_white_space(p, last) != last) {
+            return false;
+        }
 
-    number::number(const num_type& value) : _value(value) {
+        *this = number(num_type(as_real(real), negative ? -as_real(imag) : as_real(imag)));
+        return true;
     }
 
-    bool number::is_nan() const {
-        return std::isnan(_value.real()) || std::isnan(_value.imag());
-    }
+    bool number::parse_ratio(rep_type num, const char* first, const char* last) {
 
-    std::string _type_(const number& self) {
-        return "number"s;
-    }
+        rep_type den;
 
-    bool _is_(const number& self) {
+        const char* p = parse_literal(first, last, den);
 
-        if (self.is_nan()) {
+        if (!p || skip_white_space(p, last) != last) {
+            return false;
+        }
+
+        number n;
+        number d;
+
+        n._value = std::move(num);
+        d._value = std::move(den);
+
+        if (!n.is_integral() || !d.is_integral() || !_is_(d)) {
             return false;
         }
 
-        return (self._value.real() != 0 || self._value.imag() != 0);
+        if (n.type() == integer_kind && d.type() == integer_kind) {
+            *this = make_ratio(n.integer(), d.integer());
+        }
+        else {
+            *this = normalize(big_rational(n.to_big_int(), d.to_big_int()));
+        }
+        return true;
     }
 
-    order _comp_(const number& self, const var other) {
+    bool number::parse_decimal(std::string_view str) {
 
-        auto ptr = other.cast<number>();
+        const char* p    = str.data();
+        const char* last = p + str.size();
 
-        if (ptr) {
-            if (self.is_nan() || ptr->is_nan() || self._value.imag() || ptr->_value.imag()) {
-                return order::unordered;
+        bool negative = false;
+
+        if (p != last && (*p == '+' || *p == '-')) {
+            negative = *p == '-';
+            ++p;
+        }
+
+        std::uint64_t coef     = 0;
+        std::size_t   digits   = 0;
+        std::size_t   scale    = 0;
+        bool          point    = false;
+        bool          overflow = false;
+
+        for (; p != last; ++p) {
+
+            if (*p == '.' && !point) {
+                point = true;
+                continue;
             }
 
-            auto x = self._value.real();
-            auto y = ptr->_value.real();
+            if (*p < '0' || *p > '9') {
+                return false;
+            }
 
-            if (x > y) {
-                return order::greater;
+            overflow = overflow || coef > (std::numeric_limits<std::uint64_t>::max() - 9) / 10;
+            coef     = coef * 10 + static_cast<std::uint64_t>(*p - '0');
+
+            ++digits;
+            scale += point;
+        }
+
+        if (!digits) {
+            return false;
+        }
+
+        if (overflow || scale > max_scale || coef > std::uint64_t(std::numeric_limits<int_type>::max())) {
+
+            // Too many digits for an 'int64', so the value is kept exactly as a big rational.
+            std::string text(negative ? "-" : "");
+
+            for (char c : str) {
+                if (c >= '0' && c <= '9' && (c != '0' || text.size() > negative)) {  // Leading zeros would read as octal.
+                    text.push_back(c);
+                }
             }
 
-            if (x < y) {
-                return order::less;
+            if (text.size() == negative) {
+                text.push_back('0');
             }
 
-            return order::equivalent;
+            *this = normalize(big_rational(big_int(text), big_int(boost::multiprecision::pow(big_int(10), static_cast<unsigned>(scale)))));
+            return true;
         }
 
-        return order::unordered;
+        const int_type x = static_cast<int_type>(coef);
+
+        *this = number(decimal_type{ negative ? -x : x, static_cast<std::uint8_t>(scale) });
+        return true;
     }
 
-    std::string _str_(const number& self, const Format_Args& fmt) {
+    const char* number::parse_literal(const char* first, const char* last, rep_type& x) {
+
+        const char* p = first;
+        bool negative = false;
+
+        if (p != last && (*p == '+' || *p == '-')) {
+            negative = *p == '-';
+            ++p;
+        }
+
+        const std::string_view rest(p, static_cast<std::size_t>(last - p));
+
+        if (starts_with_no_case(rest, "nan")) {
+            x = std::numeric_limits<val_type>::quiet_NaN();
+            return p + 3;
+        }
+
+        if (starts_with_no_case(rest, "inf")) {
+            x = negative ? -std::numeric_limits<val_type>::infinity() : std::numeric_limits<val_type>::infinity();
+            return p + (starts_with_no_case(rest, "infinity") ? 8 : 3);
+        }
+
+        const char* digits = p;
+
+        while (digits != last && *digits >= '0' && *digits <= '9') {
+            ++digits;
+        }
+
+        if (digits == p && (digits == last || *digits != '.')) {
+            return nullptr;
+        }
 
-        auto real = self._value.real();
-        auto imag = self._value.imag();
+        // An integer literal is exact, in an int64 when it fits.
+        if (digits == last || (*digits != '.' && *digits != 'e' && *digits != 'E')) {
 
-        if (imag && !real) {
+            std::uint64_t u = 0;
 
-            return fmt::format("{}j", imag);
+            auto [q, ec] = std::from_chars(p, digits, u);
+
+            if (ec == std::errc() && u <= std::uint64_t(std::numeric_limits<int_type>::max()) + negative) {
+                x = negative ? static_cast<int_type>(0 - u) : static_cast<int_type>(u);
+            }
+            else {
+                const char* lead = p;
+
+                while (lead + 1 != digits && *lead == '0') {  // Leading zeros would read as octal.
+                    ++lead;
+                }
+
+                big_int i(std::string(lead, digits));
+                x = std::make_shared<const big_int>(negative ? big_int(-i) : i);
+            }
+            return digits;
         }
 
-        if (!imag) {
+        val_type d = 0;
+
+        auto [q, ec] = std::from_chars(p, last, d, std::chars_format::general);
+
+        if (ec == std::errc::invalid_argument) {
+            return nullptr;
+        }
 
-            return fmt::format("{}", real);
+        // More significant digits than a double holds, (or a magnitude beyond a
+        // double's range), requests a big float.
+        if (ec == std::errc::result_out_of_range || significant_digits(p, q) > std::numeric_limits<val_type>::max_digits10) {
+            x = std::make_shared<const big_float>(std::string(first, q));
         }
+        else {
+            x = negative ? -d : d;
+        }
+        return q;
+    }
+
+    std::size_t number::significant_digits(const char* first, const char* last) {
+
+        std::size_t count = 0;
 
-        return fmt::format("({},{}j)", real, imag);
+        for (; first != last && *first != 'e' && *first != 'E'; ++first) {
+
+            if (*first >= '0' && *first <= '9' && (count || *first != '0')) {
+                ++count;
+            }
+        }
+        return count;
     }
 
-    var _add_(number& self, var other) {
-        fmt::println("CALLED");
-        
-        auto ptr = other.cast<number>();
+    bool number::starts_with_no_case(std::string_view str, std::string_view lower) {
 
-        if (!ptr) {
-            return var();
+        if (str.size() < lower.size()) {
+            return false;
         }
 
-        return number(self._value + ptr->_value);
+        for (std::size_t i = 0; i < lower.size(); ++i) {
+
+            if ((str[i] | 0x20) != lower[i]) {
+                return false;
+            }
+        }
+        return true;
     }
 
-    var _sub_(number& self, var other) {
+    std::string_view number::trim(std::string_view str) {
 
-        auto ptr = other.cast<number>();
+        auto first = str.find_first_not_of(" \t\n\r");
 
-        if (!ptr) {
-            return var();
+        if (first == std::string_view::npos) {
+            return {};
         }
 
-        return number(self._value - ptr->_value);
+        return str.substr(first, str.find_last_not_of(" \t\n\r") - first + 1);
     }
 
-    var _mul_(number& self, var other) {
+    const char* number::skip_white_space(const char* first, const char* last) {
 
-        auto ptr = other.cast<number>();
+        while (first != last && (*first == ' ' || *first == '\t')) {
+            ++first;
+        }
+        return first;
+    }
 
-        if (!ptr) {
-            return var();
+    number::val_type number::as_real(const rep_type& x) {
+
+        number n;
+        n._value = x;
+        return n.to_real();
+    }
+
+    /*
+        The writers append a number to the buffer, following the 'Format_Args'
+        of its format specification.  Each returns the position in the buffer
+        after any sign and base prefix, which is where zero padding goes.
+    */
+    std::size_t number::write_sign(fmt::memory_buffer& out, bool negative, const Format_Args& fmt) {
+
+        if (negative) {
+            out.push_back('-');
+        }
+        else if (fmt.sign == '+' || fmt.sign == ' ') {
+            out.push_back(fmt.sign);
+        }
+        return out.size();
+    }
+
+    std::size_t number::write_integer(fmt::memory_buffer& out, int_type x, const Format_Args& fmt) {
+
+        if (fmt.base != 2 && fmt.base != 8 && fmt.base != 10 && fmt.base != 16) {
+            return write_real(out, static_cast<val_type>(x), fmt);
+        }
+
+        write_sign(out, x < 0, fmt);
+
+        if (fmt.pref && fmt.base != 10) {
+            out.push_back('0');
+
+            if (fmt.base != 8) {
+                out.push_back(fmt.pref);
+            }
+        }
+
+        const std::size_t digits = out.size();
+
+        const std::uint64_t magnitude = x < 0 ? 0 - static_cast<std::uint64_t>(x) : static_cast<std::uint64_t>(x);
+
+        char buffer[64];
+
+        auto [last, ec] = std::to_chars(std::begin(buffer), std::end(buffer), magnitude, fmt.base);
+
+        if (fmt.type == 'X') {
+            std::transform(std::begin(buffer), last, std::begin(buffer), [](char c) { return c >= 'a' ? char(c - 'a' + 'A') : c; });
         }
 
-        return number(self._value * ptr->_value);
+        out.append(std::begin(buffer), last);
+
+        return digits;
     }
 
-    var _div_(number& self, var other) {
+    std::size_t number::write_real(fmt::memory_buffer& out, val_type x, const Format_Args& fmt) {
 
-        auto ptr = other.cast<number>();
+        // An integral real in another base is written as an integer.
+        if ((fmt.base == 2 || fmt.base == 8 || fmt.base == 16) && x == std::trunc(x) && std::abs(x) < 0x1p63) {
+            return write_integer(out, static_cast<int_type>(x), fmt);
+        }
 
-        if (!ptr) {
-            return var();
+        const std::size_t digits = write_sign(out, std::signbit(x) && !std::isnan(x), fmt);
+
+        x = std::abs(x);
+
+        if (std::isnan(x) || std::isinf(x)) {
+            const std::string_view str = std::isnan(x) ? "nan" : "inf";
+            out.append(str.data(), str.data() + str.size());
+            return digits;
+        }
+
+        char buffer[512];
+
+        std::to_chars_result result{};
+
+        const bool precise = fmt.prec >= 0;
+
+        switch (fmt.type) {
+
+        case 'e':
+        case 'E':
+            result = precise ? std::to_chars(std::begin(buffer), std::end(buffer), x, std::chars_format::scientific, fmt.prec)
+                             : std::to_chars(std::begin(buffer), std::end(buffer), x, std::chars_format::scientific);
+            break;
+
+        case 'f':
+        case 'F':
+            result = precise ? std::to_chars(std::begin(buffer), std::end(buffer), x, std::chars_format::fixed, fmt.prec)
+                             : std::to_chars(std::begin(buffer), std::end(buffer), x, std::chars_format::fixed);
+            break;
+
+        case 'a':
+        case 'A':
+            result = precise ? std::to_chars(std::begin(buffer), std::end(buffer), x, std::chars_format::hex, fmt.prec)
+                             : std::to_chars(std::begin(buffer), std::end(buffer), x, std::chars_format::hex);
+            break;
+
+        default:
+            result = precise ? std::to_chars(std::begin(buffer), std::end(buffer), x, std::chars_format::general, fmt.prec)
+                             : std::to_chars(std::begin(buffer), std::end(buffer), x);
+            break;
+        }
+
+        if (result.ec != std::errc()) {  // Too long for the buffer, so fall back on the shortest form.
+            result = std::to_chars(std::begin(buffer), std::end(buffer), x);
         }
 
-        return number(self._value / ptr->_value);
+        if (fmt.type >= 'A' && fmt.type <= 'Z') {
+            std::transform(std::begin(buffer), result.ptr, std::begin(buffer), [](char c) { return c >= 'a' && c <= 'z' ? char(c - 'a' + 'A') : c; });
+        }
+
+        out.append(std::begin(buffer), result.ptr);
+
+        return digits;
     }
 
-    var _mod_(number& self, var other) {
+    std::size_t number::write_big(const number& self, fmt::memory_buffer& out, const Format_Args& fmt) {
 
-        auto ptr = other.cast<number>();
+        std::string str;
+        bool   negative = false;
 
-        if (ptr) {
+        if (self.type() == big_int_kind) {
+
+            std::ios_base::fmtflags flags = fmt.base == 16 ? std::ios_base::hex : fmt.base == 8 ? std::ios_base::oct : std::ios_base::dec;
 
-            if (self.is_nan() || ptr->is_nan() || self._value.imag() || ptr->_value.imag()) {
-                return number("nan");
+            if (fmt.type == 'X') {
+                flags |= std::ios_base::uppercase;
             }
 
-            return number((unsigned long long)self._value.real() % (unsigned long long)ptr->_value.real());
+            auto x = self.to_big_int();
+
+            negative = x.sign() < 0;
+            str = decltype(x)(boost::multiprecision::abs(x)).str(0, flags);
+        }
+        else {
+
+            std::ios_base::fmtflags flags = fmt.type == 'f' || fmt.type == 'F' ? std::ios_base::fixed
+                                          : fmt.type == 'e' || fmt.type == 'E' ? std::ios_base::scientific : std::ios_base::fmtflags{};
+
+            auto x = self.to_big_float();
+
+            negative = x.sign() < 0;
+            str = decltype(x)(boost::multiprecision::abs(x)).str(fmt.prec >= 0 ? fmt.prec : std::numeric_limits<big_float>::digits10, flags);
         }
 
-        return var();
+        const std::size_t digits = write_sign(out, negative, fmt);
+
+        out.append(str.data(), str.data() + str.size());
+
+        return digits;
     }
 
-    var _neg_(number& self) {
+    std::size_t number::write_ratio(const number& self, fmt::memory_buffer& out, const Format_Args& fmt) {
 
-        if (self.is_nan()) {
-            return number("nan");
+        // The denominator is positive, and written without a sign or prefix.
+        Format_Args part = fmt;
+        part.sign = '-';
+        part.pref = 0;
+
+        if (self.type() == rational_kind) {
+
+            auto x = self.as_ratio();
+
+            const std::size_t digits = write_integer(out, x.num, fmt);
+
+            out.push_back('/');
+            write_integer(out, x.den, part);
+
+            return digits;
         }
 
-        return number(-self._value);
+        auto x = self.to_big_rational();
+
+        const std::size_t digits = write_big(number(big_int(boost::multiprecision::numerator(x))), out, fmt);
+
+        out.push_back('/');
+        write_big(number(big_int(boost::multiprecision::denominator(x))), out, part);
+
+        return digits;
     }
 
-    var _f_div_(const number& self, var other) {
+    /*
+        A decimal is written with every digit of its scale, followed by its
+        suffix, so that it reads back as the same decimal.  The fixed format
+        rounds half to even, to a given precision, and omits the suffix.  Any
+        other format is that of the nearest real.
+    */
+    std::size_t number::write_decimal(fmt::memory_buffer& out, decimal_type x, const Format_Args& fmt) {
 
-        auto ptr = other.cast<number>();
+        const bool fixed = fmt.type == 'f' || fmt.type == 'F';
 
-        if (ptr) {
+        if (!fixed && (fmt.base != 10 || fmt.type != 'd')) {
+            return write_real(out, static_cast<val_type>(x.coef) / static_cast<val_type>(pow10(x.scale)), fmt);
+        }
+
+        std::uint64_t magnitude = x.coef < 0 ? 0 - static_cast<std::uint64_t>(x.coef) : static_cast<std::uint64_t>(x.coef);
+        std::size_t   scale     = x.scale;
+
+        if (fixed && fmt.prec >= 0 && static_cast<std::size_t>(fmt.prec) < scale) {
 
-            if (self.is_nan() || ptr->is_nan() || self._value.imag() || ptr->_value.imag()) {
-                return number("nan");
+            const auto d = static_cast<std::uint64_t>(pow10(static_cast<std::uint8_t>(scale - fmt.prec)));
+            const auto r = magnitude % d;
+
+            magnitude /= d;
+
+            if (r > d / 2 || (r == d / 2 && (magnitude & 1))) {
+                ++magnitude;
             }
 
-            //return number(std::floor(static_cast<int64_t>(self._value.real() / ptr->_value.real())));
-            return number();
+            scale = static_cast<std::size_t>(fmt.prec);
         }
 
-        return var();
-    }
+        const std::size_t digits = write_sign(out, x.coef < 0 && magnitude, fmt);
 
-    var _rem_(const number& self, var other) {
+        char buffer[24];
 
-        auto ptr = other.cast<number>();
+        auto [last, ec] = std::to_chars(std::begin(buffer), std::end(buffer), magnitude);
 
-        if (ptr) {
+        const std::size_t length = static_cast<std::size_t>(last - std::begin(buffer));
+
+        // The leading zeros of a value less than one.
+        if (length <= scale) {
+            out.push_back('0');
+
+            if (scale) {
+                out.push_back('.');
+            }
 
-            if (self.is_nan() || ptr->is_nan() || self._value.imag() || ptr->_value.imag()) {
-                return number("nan");
+            out.resize(out.size() + scale - length);
+            std::fill_n(out.data() + out.size() - (scale - length), scale - length, '0');
+            out.append(std::begin(buffer), last);
+        }
+        else {
+            out.append(std::begin(buffer), last - scale);
+
+            if (scale) {
+                out.push_back('.');
+                out.append(last - scale, last);
+            }
+        }
+
+        if (fixed && fmt.prec >= 0 && static_cast<std::size_t>(fmt.prec) > scale) {
+
+            if (!scale) {
+                out.push_back('.');
             }
 
-            auto r = self._value.real() / ptr->_value.real();
+            const std::size_t zeros = static_cast<std::size_t>(fmt.prec) - scale;
+
+            out.resize(out.size() + zeros);
+            std::fill_n(out.data() + out.size() - zeros, zeros, '0');
+        }
 
-            // return number(r - static_cast<number::val_type>(std::floor(static_cast<int64_t>(r))));
-            return number();
+        if (!fixed) {
+            out.push_back('d');
         }
 
-        return var();
+        return digits;
     }
 
-    var _pow_(const number& self, var other) {
+    void number::pad(fmt::memory_buffer& out, std::size_t start, std::size_t digits, const Format_Args& fmt) {
 
-        auto ptr = other.cast<number>();
+        const std::size_t length = out.size() - start;
 
-        if (ptr) {
+        if (fmt.width <= 0 || static_cast<std::size_t>(fmt.width) <= length) {
+            return;
+        }
 
-            if (self.is_nan() || ptr->is_nan()) {
-                return number("nan");
-            }
+        const std::size_t count = static_cast<std::size_t>(fmt.width) - length;
+
+        // Zero padding goes between the sign and the digits, otherwise the fill
+        // character is placed according to the alignment.
+        const std::size_t before = fmt.pad ? count : fmt.align == '>' ? count : fmt.align == '^' ? count / 2 : 0;
+        const std::size_t after  = count - before;
+        const std::size_t at     = fmt.pad ? digits : start;
+        const char        fill   = fmt.pad ? '0' : fmt.fill;
+
+        const std::size_t end   = out.size();
+
+        out.resize(end + count);
 
-            return number(std::pow(self._value, ptr->_value));
+        std::copy_backward(out.data() + at, out.data() + end, out.data() + end + before);
+        std::fill_n(out.data() + at, before, fill);
+        std::fill_n(out.data() + end + before, after, fill);
+    }
+
+    number::number(long long value) : _value(static_cast<int_type>(value)) {
+    }
+
+    number::number(const num_type& value) : _value(value) {
+
+        if (value.imag() == 0.0) {
+            _value = value.real();
+        }
+    }
+
+    number::number(big_int value) : _value(std::make_shared<const big_int>(std::move(value))) {
+    }
+
+    number::number(big_float value) : _value(std::make_shared<const big_float>(std::move(value))) {
+    }
+
+    number::number(ratio_type value) : _value(value) {
+    }
+
+    number::number(big_rational value) : _value(std::make_shared<const big_rational>(std::move(value))) {
+    }
+
+    number::number(decimal_type value) : _value(value) {
+    }
+
+    number::kind number::type() const {
+        return static_cast<kind>(_value.index());
+    }
+
+    bool number::is_nan() const {
+
+        switch (type()) {
+
+        case real_kind:
+            return std::isnan(*std::get_if<val_type>(&_value));
+
+        case complex_kind: {
+            auto& x = *std::get_if<num_type>(&_value);
+            return std::isnan(x.real()) || std::isnan(x.imag());
+        }
+
+        case big_float_kind:
+            return boost::multiprecision::isnan(**std::get_if<std::shared_ptr<const big_float>>(&_value));
+
+        default:
+            return false;
         }
+    }
+
+    bool number::is_negative() const {
+
+        switch (type()) {
+
+        case integer_kind:
+            return integer() < 0;
+
+        case real_kind:
+            return *std::get_if<val_type>(&_value) < 0;
+
+        case complex_kind:
+            return false;
+
+        case big_int_kind:
+            return to_big_int().sign() < 0;
+
+        case big_float_kind:
+            return to_big_float().sign() < 0;
+
+        case rational_kind:
+            return as_ratio().num < 0;
+
+        case decimal_kind:
+            return as_decimal().coef < 0;
+
+        default:
+            return to_big_rational().sign() < 0;
+        }
+    }
+
+    bool number::is_integral() const {
+        return type() == integer_kind || type() == big_int_kind;
+    }
+
+    number::int_type number::integer() const {
+        return *std::get_if<int_type>(&_value);
+    }
+
+    number::val_type number::to_real() const {
+
+        switch (type()) {
+
+        case integer_kind:
+            return static_cast<val_type>(integer());
+
+        case real_kind:
+            return *std::get_if<val_type>(&_value);
+
+        case big_int_kind:
+            return static_cast<val_type>(**std::get_if<std::shared_ptr<const big_int>>(&_value));
+
+        case big_float_kind:
+            return static_cast<val_type>(**std::get_if<std::shared_ptr<const big_float>>(&_value));
+
+        case rational_kind: {
+            auto x = as_ratio();
+            return static_cast<val_type>(x.num) / static_cast<val_type>(x.den);
+        }
+
+        case big_rational_kind:
+            return (**std::get_if<std::shared_ptr<const big_rational>>(&_value)).convert_to<val_type>();
+
+        case decimal_kind: {
+            auto x = as_decimal();
+            return static_cast<val_type>(x.coef) / static_cast<val_type>(pow10(x.scale));
+        }
+
+        default:
+            return std::get_if<num_type>(&_value)->real();
+        }
+    }
+
+    number::num_type number::to_complex() const {
+
+        if (type() == complex_kind) {
+            return *std::get_if<num_type>(&_value);
+        }
+
+        return num_type(to_real(), 0.0);
+    }
+
+    number::big_int number::to_big_int() const {
+
+        if (type() == integer_kind) {
+            return big_int(integer());
+        }
+
+        return **std::get_if<std::shared_ptr<const big_int>>(&_value);
+    }
+
+    number::big_float number::to_big_float() const {
+
+        switch (type()) {
+
+        case integer_kind:
+            return big_float(integer());
+
+        case big_int_kind:
+            return big_float(**std::get_if<std::shared_ptr<const big_int>>(&_value));
+
+        case big_float_kind:
+            return **std::get_if<std::shared_ptr<const big_float>>(&_value);
+
+        case rational_kind:
+        case big_rational_kind:
+        case decimal_kind: {
+            auto x = to_big_rational();
+            return big_float(big_float(boost::multiprecision::numerator(x)) / big_float(boost::multiprecision::denominator(x)));
+        }
+
+        default:
+            return big_float(to_real());
+        }
+    }
+
+    bool number::is_exact() const {
+        return is_integral() || type() == rational_kind || type() == big_rational_kind || type() == decimal_kind;
+    }
+
+    number::ratio_type number::as_ratio() const {
+
+        if (type() == integer_kind) {
+            return { integer(), 1 };
+        }
+
+        return *std::get_if<ratio_type>(&_value);
+    }
+
+    number::decimal_type number::as_decimal() const {
+
+        if (type() == integer_kind) {
+            return { integer(), 0 };
+        }
+
+        return *std::get_if<decimal_type>(&_value);
+    }
+
+    number::big_rational number::to_big_rational() const {
+
+        switch (type()) {
+
+        case rational_kind: {
+            auto x = as_ratio();
+            return big_rational(big_int(x.num), big_int(x.den));
+        }
+
+        case big_rational_kind:
+            return **std::get_if<std::shared_ptr<const big_rational>>(&_value);
+
+        case decimal_kind: {
+            auto x = as_decimal();
+            return big_rational(big_int(x.coef), big_int(pow10(x.scale)));
+        }
+
+        default:
+            return big_rational(to_big_int());
+        }
+    }
+
+    number number::normalize(big_int x) {
+
+        if (x >= std::numeric_limits<int_type>::min() && x <= std::numeric_limits<int_type>::max()) {
+            return number(static_cast<long long>(x));
+        }
+
+        return number(std::move(x));
+    }
+
+    number number::normalize(big_rational x) {
+
+        // A big rational is always held in lowest terms.
+        big_int num = boost::multiprecision::numerator(x);
+        big_int den = boost::multiprecision::denominator(x);
+
+        if (den == 1) {
+            return normalize(std::move(num));
+        }
+
+        if (num >= std::numeric_limits<int_type>::min() && num <= std::numeric_limits<int_type>::max() && den <= std::numeric_limits<int_type>::max()) {
+            return number(ratio_type{ static_cast<int_type>(num), static_cast<int_type>(den) });
+        }
+
+        return number(std::move(x));
+    }
+
+    number number::make_ratio(int_type num, int_type den) {
+
+        // Reduced as magnitudes, so that negating 'int64' min can not overflow.
+        const bool          negative = (num < 0) != (den < 0);
+        std::uint64_t       n        = num < 0 ? 0 - static_cast<std::uint64_t>(num) : static_cast<std::uint64_t>(num);
+        std::uint64_t       d        = den < 0 ? 0 - static_cast<std::uint64_t>(den) : static_cast<std::uint64_t>(den);
+        const std::uint64_t g        = gcd(n, d);
+
+        n /= g;
+        d /= g;
+
+        constexpr std::uint64_t max = std::numeric_limits<int_type>::max();
+
+        if (n > max + negative || d > max) {
+            big_int x(n);
+            return normalize(big_rational(negative ? big_int(-x) : x, big_int(d)));
+        }
+
+        const int_type x = negative ? static_cast<int_type>(0 - n) : static_cast<int_type>(n);
+
+        if (d == 1) {
+            return number(x);
+        }
+
+        return number(ratio_type{ x, static_cast<int_type>(d) });
+    }
+
+    /*
+        Stein's binary gcd, using only shifts and subtraction.
+    */
+    std::uint64_t number::gcd(std::uint64_t a, std::uint64_t b) {
+
+        if (a == 0 || b == 0) {
+            return a | b;
+        }
+
+        const int shift = std::countr_zero(a | b);
+
+        a >>= std::countr_zero(a);
+
+        do {
+            b >>= std::countr_zero(b);
+
+            if (a > b) {
+                std::swap(a, b);
+            }
+
+            b -= a;
+
+        } while (b);
+
+        return a << shift;
+    }
+
+    /*
+        The rational kernels return nothing when an 'int64' overflows, for the
+        caller to retry with big rationals.  Integers are the ratios 'n/1', for
+        which the gcd is skipped.  Otherwise the operands are already in lowest
+        terms, so only a gcd of the denominators and one of the numerator are
+        needed, (Knuth, TAOCP 4.5.1), rather than reducing the full products.
+    */
+    std::optional<number> number::add_ratio(ratio_type x, ratio_type y) {
+
+        int_type n;
+        int_type d;
+
+        if (x.den == 1 && y.den == 1) {
+
+            if (add_overflow(x.num, y.num, n)) {
+                return std::nullopt;
+            }
+            return number(n);
+        }
+
+        const int_type g = static_cast<int_type>(gcd(static_cast<std::uint64_t>(x.den), static_cast<std::uint64_t>(y.den)));
+
+        int_type a;
+        int_type b;
+
+        if (mul_overflow(x.num, y.den / g, a) || mul_overflow(y.num, x.den / g, b) || add_overflow(a, b, n)) {
+            return std::nullopt;
+        }
+
+        if (n == 0) {
+            return number(0ll);
+        }
+
+        const int_type h = g == 1 ? 1 : static_cast<int_type>(gcd(n < 0 ? 0 - static_cast<std::uint64_t>(n) : static_cast<std::uint64_t>(n), static_cast<std::uint64_t>(g)));
+
+        if (mul_overflow(x.den / g, y.den / h, d)) {
+            return std::nullopt;
+        }
+
+        n /= h;
+
+        if (d == 1) {
+            return number(n);
+        }
+
+        return number(ratio_type{ n, d });
+    }
+
+    std::optional<number> number::mul_ratio(ratio_type x, ratio_type y) {
+
+        int_type n;
+        int_type d;
+
+        if (x.den == 1 && y.den == 1) {
+
+            if (mul_overflow(x.num, y.num, n)) {
+                return std::nullopt;
+            }
+            return number(n);
+        }
+
+        if (x.num == 0 || y.num == 0) {
+            return number(0ll);
+        }
+
+        auto magnitude = [](int_type i) { return i < 0 ? 0 - static_cast<std::uint64_t>(i) : static_cast<std::uint64_t>(i); };
+
+        // Cross reduce, each numerator shares no factor with its own denominator.
+        const int_type g = static_cast<int_type>(gcd(magnitude(x.num), static_cast<std::uint64_t>(y.den)));
+        const int_type h = static_cast<int_type>(gcd(magnitude(y.num), static_cast<std::uint64_t>(x.den)));
+
+        if (mul_overflow(x.num / g, y.num / h, n) || mul_overflow(x.den / h, y.den / g, d)) {
+            return std::nullopt;
+        }
+
+        if (d == 1) {
+            return number(n);
+        }
+
+        return number(ratio_type{ n, d });
+    }
+
+    number::int_type number::pow10(std::uint8_t n) {
+
+        static constexpr auto table = [] {
+            std::array<int_type, max_scale + 1> t{};
+
+            t[0] = 1;
+
+            for (std::size_t i = 1; i < t.size(); ++i) {
+                t[i] = t[i - 1] * 10;
+            }
+            return t;
+        }();
+
+        return table[n];
+    }
+
+    bool number::align(decimal_type& x, decimal_type& y) {
+
+        decimal_type& small = x.scale < y.scale ? x : y;
+        decimal_type& large = x.scale < y.scale ? y : x;
+
+        if (small.scale == large.scale) {
+            return true;
+        }
+
+        if (mul_overflow(small.coef, pow10(static_cast<std::uint8_t>(large.scale - small.scale)), small.coef)) {
+            return false;
+        }
+
+        small.scale = large.scale;
+        return true;
+    }
+
+    /*
+        The integer quotient, or the remainder, of two exact numbers.  For
+        'a / b' equal to 'n / d', with 'n = a.num * b.den' and 'd = a.den * b.num',
+        the quotient is 'n / d' rounded, and the remainder 'a - q * b' is then
+        '(n - q * d) / (a.den * b.den)'.  The divisor 'b' must not be zero.
+    */
+    number number::divide_exact(const number& a, const number& b, rounding mode, bool remainder) {
+
+        // Decimals at one scale divide as integers, and the remainder keeps the scale.
+        if (common_kind(a, b) == decimal_kind) {
+
+            auto x = a.as_decimal();
+            auto y = b.as_decimal();
+
+            if (align(x, y) && !(y.coef == -1 && x.coef == std::numeric_limits<int_type>::min())) {
+
+                int_type q = x.coef / y.coef;
+                int_type r = x.coef % y.coef;
+
+                if (mode == floor && r != 0 && ((r < 0) != (y.coef < 0))) {
+                    --q;
+                    r += y.coef;
+                }
+
+                return remainder ? number(decimal_type{ r, x.scale }) : number(q);
+            }
+        }
+
+        if ((a.type() == integer_kind || a.type() == rational_kind) && (b.type() == integer_kind || b.type() == rational_kind)) {
+
+            auto x = a.as_ratio();
+            auto y = b.as_ratio();
+
+            int_type n;
+            int_type d;
+            int_type s;
+
+            if (!mul_overflow(x.num, y.den, n) && !mul_overflow(x.den, y.num, d) && !mul_overflow(x.den, y.den, s)
+                && !(d == -1 && n == std::numeric_limits<int_type>::min())) {
+
+                int_type q = n / d;
+                int_type r = n % d;
+
+                if (mode == floor && r != 0 && ((r < 0) != (d < 0))) {
+                    --q;
+                    r += d;
+                }
+
+                return remainder ? make_ratio(r, s) : number(q);
+            }
+        }
+
+        auto x = a.to_big_rational();
+        auto y = b.to_big_rational();
+
+        big_int n = big_multiply(big_int(boost::multiprecision::numerator(x)), big_int(boost::multiprecision::denominator(y)));
+        big_int d = big_multiply(big_int(boost::multiprecision::denominator(x)), big_int(boost::multiprecision::numerator(y)));
+        big_int q;
+        big_int r;
+
+        big_divide(n, d, q, r);
+
+        if (mode == floor && !r.is_zero() && ((r.sign() < 0) != (d.sign() < 0))) {
+            --q;
+            r += d;
+        }
+
+        if (remainder) {
+            return normalize(big_rational(r, big_int(boost::multiprecision::denominator(x) * boost::multiprecision::denominator(y))));
+        }
+
+        return normalize(std::move(q));
+    }
+
+    number::kind number::common_kind(const number& a, const number& b) {
+
+        // A value with an imaginary part can only be combined as a complex.
+        if (a.type() == complex_kind || b.type() == complex_kind) {
+            return complex_kind;
+        }
+
+        if (a.is_integral() && b.is_integral()) {
+            return a.type() == integer_kind && b.type() == integer_kind ? integer_kind : big_int_kind;
+        }
+
+        if ((a.type() == decimal_kind || b.type() == decimal_kind) && (a.type() == integer_kind || a.type() == decimal_kind)
+                                                                    && (b.type() == integer_kind || b.type() == decimal_kind)) {
+            return decimal_kind;
+        }
+
+        if (a.is_exact() && b.is_exact()) {
+            auto small = [](const number& x) { return x.type() == integer_kind || x.type() == rational_kind; };
+
+            return small(a) && small(b) ? rational_kind : big_rational_kind;
+        }
+
+        if (a.type() == big_float_kind || b.type() == big_float_kind) {
+            return big_float_kind;
+        }
+
+        return real_kind;
+    }
+
+    bool number::add_overflow(int_type a, int_type b, int_type& r) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_add_overflow(a, b, &r);
+#else
+        if ((b > 0 && a > std::numeric_limits<int_type>::max() - b) || (b < 0 && a < std::numeric_limits<int_type>::min() - b)) {
+            return true;
+        }
+        r = a + b;
+        return false;
+#endif
+    }
+
+    bool number::sub_overflow(int_type a, int_type b, int_type& r) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_sub_overflow(a, b, &r);
+#else
+        if ((b < 0 && a > std::numeric_limits<int_type>::max() + b) || (b > 0 && a < std::numeric_limits<int_type>::min() + b)) {
+            return true;
+        }
+        r = a - b;
+        return false;
+#endif
+    }
+
+    bool number::mul_overflow(int_type a, int_type b, int_type& r) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_mul_overflow(a, b, &r);
+#else
+        constexpr int_type max = std::numeric_limits<int_type>::max();
+        constexpr int_type min = std::numeric_limits<int_type>::min();
+
+        if (a > 0 ? (b > 0 ? a > max / b : b < min / a) : (b > 0 ? a < min / b : (a != 0 && b < max / a))) {
+            return true;
+        }
+        r = a * b;
+        return false;
+#endif
+    }
+
+    number number::nan() {
+        return from_real(std::numeric_limits<val_type>::quiet_NaN());
+    }
+
+    number number::from_real(val_type x) {
+        number result;
+        result._value = x;
+        return result;
+    }
+
+    /*
+        Big numbers may lie beyond the range of a double, so are evaluated as
+        big floats.  Any other real is evaluated as a double.
+    */
+    template<typename F>
+    number number::elementary(const number& x, F f) {
+
+        switch (x.type()) {
+
+        case complex_kind:
+            return number(f(x.to_complex()));
+
+        case big_int_kind:
+        case big_float_kind:
+        case big_rational_kind:
+            return number(big_float(f(x.to_big_float())));
+
+        default:
+            return from_real(f(x.to_real()));
+        }
+    }
+
+    std::string _type_(const number& self) {
+        return "number"s;
+    }
+
+    std::int64_t _integer_type_(const number& self) {
+
+        if (self.type() == number::integer_kind) {
+            return self.integer();
+        }
+
+        if (self.type() == number::big_int_kind) {
+            return self.to_big_int().sign() < 0 ? std::numeric_limits<std::int64_t>::min() : std::numeric_limits<std::int64_t>::max();
+        }
+
+        const double x = std::trunc(self.to_real());  // A big integer which fits is already demoted.
+
+        if (std::isnan(x)) {
+            return 0;
+        }
+
+        if (x >= 0x1p63) {
+            return std::numeric_limits<std::int64_t>::max();
+        }
+
+        return x < -0x1p63 ? std::numeric_limits<std::int64_t>::min() : static_cast<std::int64_t>(x);
+    }
+
+    bool _is_(const number& self) {
+
+        switch (self.type()) {
+
+        case number::integer_kind:
+            return self.integer() != 0;
+
+        case number::big_int_kind:
+            return !self.to_big_int().is_zero();
+
+        case number::rational_kind:
+        case number::big_rational_kind:
+            return true;  // A zero rational is always demoted to an integer.
+
+        case number::decimal_kind:
+            return self.as_decimal().coef != 0;
+
+        case number::big_float_kind:
+            return !self.is_nan() && !self.to_big_float().is_zero();
+
+        case number::real_kind:
+            return !self.is_nan() && self.to_real() != 0;
+
+        default:
+            break;
+        }
+
+        if (self.is_nan()) {
+            return false;
+        }
+
+        auto x = self.to_complex();
+
+        return (x.real() != 0 || x.imag() != 0);
+    }
+
+    order _comp_(const number& self, const var& other) {
+
+        auto ptr = other.cast<number>();
+
+        if (ptr) {
+            return _comp_(self, *ptr);
+        }
+
+        return order::unordered;
+    }
+
+    order _comp_(const number& self, const number& other) {
+
+        if (self.is_nan() || other.is_nan()) {
+            return order::unordered;
+        }
+
+        auto compare = [](const auto& x, const auto& y) {
+
+            if (x > y) {
+                return order::greater;
+            }
+
+            if (x < y) {
+                return order::less;
+            }
+
+            return order::equivalent;
+        };
+
+        switch (number::common_kind(self, other)) {
+
+        case number::integer_kind:
+            return compare(self.integer(), other.integer());
+
+        case number::big_int_kind:
+            return compare(self.to_big_int(), other.to_big_int());
+
+        case number::rational_kind: {
+            auto x = self.as_ratio();
+            auto y = other.as_ratio();
+
+            // The denominators are positive, so cross multiplying keeps the order.
+            number::int_type a;
+            number::int_type b;
+
+            if (!number::mul_overflow(x.num, y.den, a) && !number::mul_overflow(y.num, x.den, b)) {
+                return compare(a, b);
+            }
+            [[fallthrough]];
+        }
+
+        case number::big_rational_kind:
+            return compare(self.to_big_rational(), other.to_big_rational());
+
+        case number::decimal_kind: {
+            auto x = self.as_decimal();
+            auto y = other.as_decimal();
+
+            if (number::align(x, y)) {
+                return compare(x.coef, y.coef);
+            }
+            return compare(self.to_big_rational(), other.to_big_rational());
+        }
+
+        case number::big_float_kind:
+            return compare(self.to_big_float(), other.to_big_float());
+
+        case number::real_kind:
+            return compare(self.to_real(), other.to_real());
+
+        default:
+            return order::unordered;
+        }
+    }
+
+    std::string _str_(const number& self, const Format_Args& fmt) {
+
+        fmt::memory_buffer buffer;
+
+        _write_(self, buffer, fmt);
+
+        return fmt::to_string(buffer);
+    }
+
+    void _write_(const number& self, fmt::memory_buffer& out, const Format_Args& fmt) {
+
+        const std::size_t start = out.size();
+        std::size_t      digits = start;
+
+        switch (self.type()) {
+
+        case number::integer_kind:
+            digits = number::write_integer(out, self.integer(), fmt);
+            break;
+
+        case number::real_kind:
+            digits = number::write_real(out, self.to_real(), fmt);
+            break;
+
+        case number::big_int_kind:
+        case number::big_float_kind:
+            digits = number::write_big(self, out, fmt);
+            break;
+
+        case number::rational_kind:
+        case number::big_rational_kind:
+            digits = number::write_ratio(self, out, fmt);
+            break;
+
+        case number::decimal_kind:
+            digits = number::write_decimal(out, self.as_decimal(), fmt);
+            break;
+
+        default: {
+            // The parts of a complex number are written without padding, which
+            // is then applied to the number as a whole.
+            Format_Args part = fmt;
+            part.width = ~0;
+            part.pad   = false;
+
+            auto x = self.to_complex();
+
+            if (x.real()) {
+                out.push_back('(');
+                number::write_real(out, x.real(), part);
+                out.push_back(',');
+            }
+
+            part.sign = '-';
+            number::write_real(out, x.imag(), part);
+            out.push_back('j');
+
+            if (x.real()) {
+                out.push_back(')');
+            }
+            break;
+        }
+        }
+
+        number::pad(out, start, digits, fmt);
+    }
+
+    var _add_(number& self, const var& other) {
+
+        auto ptr = other.cast<number>();
+
+        if (!ptr) {
+            return var();
+        }
+
+        return _add_(std::as_const(self), *ptr);
+    }
+
+    var _sub_(number& self, const var& other) {
+
+        auto ptr = other.cast<number>();
+
+        if (!ptr) {
+            return var();
+        }
+
+        return _sub_(std::as_const(self), *ptr);
+    }
+
+    var _mul_(number& self, const var& other) {
+
+        auto ptr = other.cast<number>();
+
+        if (!ptr) {
+            return var();
+        }
+
+        return _mul_(std::as_const(self), *ptr);
+    }
+
+    var _div_(number& self, const var& other) {
+
+        auto ptr = other.cast<number>();
+
+        if (!ptr) {
+            return var();
+        }
+
+        return _div_(std::as_const(self), *ptr);
+    }
+
+    var _mod_(number& self, const var& other) {
+
+        auto ptr = other.cast<number>();
+
+        if (!ptr) {
+            return var();
+        }
+
+        return _mod_(std::as_const(self), *ptr);
+    }
+
+    var _add_(const number& self, const number& other) {
+
+        switch (number::common_kind(self, other)) {
+
+        case number::integer_kind: {
+            number::int_type r;
+
+            if (!number::add_overflow(self.integer(), other.integer(), r)) {
+                return number(r);
+            }
+            [[fallthrough]];
+        }
+
+        case number::big_int_kind:
+            return number::normalize(self.to_big_int() + other.to_big_int());
+
+        case number::rational_kind:
+            if (auto r = number::add_ratio(self.as_ratio(), other.as_ratio())) {
+                return *r;
+            }
+            [[fallthrough]];
+
+        case number::big_rational_kind:
+            return number::normalize(number::big_rational(self.to_big_rational() + other.to_big_rational()));
+
+        case number::decimal_kind: {
+            auto x = self.as_decimal();
+            auto y = other.as_decimal();
+
+            number::int_type r;
+
+            if (number::align(x, y) && !number::add_overflow(x.coef, y.coef, r)) {
+                return number(number::decimal_type{ r, x.scale });
+            }
+            return number::normalize(number::big_rational(self.to_big_rational() + other.to_big_rational()));
+        }
+
+        case number::big_float_kind:
+            return number(number::big_float(self.to_big_float() + other.to_big_float()));
+
+        case number::real_kind:
+            return number::from_real(self.to_real() + other.to_real());
+
+        default:
+            return number(self.to_complex() + other.to_complex());
+        }
+    }
+
+    var _sub_(const number& self, const number& other) {
+
+        switch (number::common_kind(self, other)) {
+
+        case number::integer_kind: {
+            number::int_type r;
+
+            if (!number::sub_overflow(self.integer(), other.integer(), r)) {
+                return number(r);
+            }
+            [[fallthrough]];
+        }
+
+        case number::big_int_kind:
+            return number::normalize(self.to_big_int() - other.to_big_int());
+
+        case number::rational_kind: {
+            auto y = other.as_ratio();
+
+            if (y.num != std::numeric_limits<number::int_type>::min()) {
+
+                if (auto r = number::add_ratio(self.as_ratio(), { -y.num, y.den })) {
+                    return *r;
+                }
+            }
+            [[fallthrough]];
+        }
+
+        case number::big_rational_kind:
+            return number::normalize(number::big_rational(self.to_big_rational() - other.to_big_rational()));
+
+        case number::decimal_kind: {
+            auto x = self.as_decimal();
+            auto y = other.as_decimal();
+
+            number::int_type r;
+
+            if (number::align(x, y) && !number::sub_overflow(x.coef, y.coef, r)) {
+                return number(number::decimal_type{ r, x.scale });
+            }
+            return number::normalize(number::big_rational(self.to_big_rational() - other.to_big_rational()));
+        }
+
+        case number::big_float_kind:
+            return number(number::big_float(self.to_big_float() - other.to_big_float()));
+
+        case number::real_kind:
+            return number::from_real(self.to_real() - other.to_real());
+
+        default:
+            return number(self.to_complex() - other.to_complex());
+        }
+    }
+
+    var _mul_(const number& self, const number& other) {
+
+        switch (number::common_kind(self, other)) {
+
+        case number::integer_kind: {
+            number::int_type r;
+
+            if (!number::mul_overflow(self.integer(), other.integer(), r)) {
+                return number(r);
+            }
+            [[fallthrough]];
+        }
+
+        case number::big_int_kind:
+            return number::normalize(big_multiply(self.to_big_int(), other.to_big_int()));
+
+        case number::rational_kind:
+            if (auto r = number::mul_ratio(self.as_ratio(), other.as_ratio())) {
+                return *r;
+            }
+            [[fallthrough]];
+
+        case number::big_rational_kind:
+            return number::normalize(number::big_rational(self.to_big_rational() * other.to_big_rational()));
+
+        case number::decimal_kind: {
+            auto x = self.as_decimal();
+            auto y = other.as_decimal();
+
+            number::int_type r;
+
+            // The scales add, the product is exact while it fits.
+            if (x.scale + y.scale <= number::max_scale && !number::mul_overflow(x.coef, y.coef, r)) {
+                return number(number::decimal_type{ r, static_cast<std::uint8_t>(x.scale + y.scale) });
+            }
+            return number::normalize(number::big_rational(self.to_big_rational() * other.to_big_rational()));
+        }
+
+        case number::big_float_kind:
+            return number(number::big_float(self.to_big_float() * other.to_big_float()));
+
+        case number::real_kind:
+            return number::from_real(self.to_real() * other.to_real());
+
+        default:
+            return number(self.to_complex() * other.to_complex());
+        }
+    }
+
+    var _div_(const number& self, const number& other) {
+
+        switch (number::common_kind(self, other)) {
+
+        case number::integer_kind: {
+            auto a = self.integer();
+            auto b = other.integer();
+
+            // An exact quotient stays an integer, (the one overflow is 'min / -1').
+            if (b != 0 && a % b == 0 && !(b == -1 && a == std::numeric_limits<number::int_type>::min())) {
+                return number(a / b);
+            }
+            break;
+        }
+
+        case number::big_int_kind: {
+            auto a = self.to_big_int();
+            auto b = other.to_big_int();
+
+            if (b.is_zero()) {
+                break;
+            }
+
+            number::big_int q;
+            number::big_int r;
+
+            big_divide(a, b, q, r);
+
+            if (r.is_zero()) {
+                return number::normalize(std::move(q));
+            }
+
+            return number(number::big_float(number::big_float(a) / number::big_float(b)));
+        }
+
+        case number::rational_kind: {
+            auto y = other.as_ratio();
+
+            if (y.num == 0) {
+                break;
+            }
+
+            // Multiply by the reciprocal, keeping the denominator positive.
+            if (y.num != std::numeric_limits<number::int_type>::min()) {
+
+                number::ratio_type inverse = y.num < 0 ? number::ratio_type{ -y.den, -y.num } : number::ratio_type{ y.den, y.num };
+
+                if (auto r = number::mul_ratio(self.as_ratio(), inverse)) {
+                    return *r;
+                }
+            }
+            [[fallthrough]];
+        }
+
+        case number::big_rational_kind: {
+            auto b = other.to_big_rational();
+
+            if (b.is_zero()) {
+                break;
+            }
+
+            return number::normalize(number::big_rational(self.to_big_rational() / b));
+        }
+
+        case number::decimal_kind: {
+            auto x = self.as_decimal();
+            auto y = other.as_decimal();
+
+            if (y.coef == 0) {
+                break;
+            }
+
+            // The quotient of two decimals at one scale is a decimal when it
+            // terminates, at the first scale where the division is exact.
+            if (number::align(x, y)) {
+
+                for (std::uint8_t scale = 0; scale <= number::max_scale; ++scale) {
+
+                    number::int_type n;
+
+                    if (number::mul_overflow(x.coef, number::pow10(scale), n)) {
+                        break;
+                    }
+
+                    if (n % y.coef == 0 && !(y.coef == -1 && n == std::numeric_limits<number::int_type>::min())) {
+                        return number(number::decimal_type{ n / y.coef, scale });
+                    }
+                }
+            }
+            return number::normalize(number::big_rational(self.to_big_rational() / other.to_big_rational()));
+        }
+
+        case number::big_float_kind:
+            return number(number::big_float(self.to_big_float() / other.to_big_float()));
+
+        case number::complex_kind:
+            return number(self.to_complex() / other.to_complex());
+
+        default:
+            break;
+        }
+
+        return number::from_real(self.to_real() / other.to_real());
+    }
+
+    var _mod_(const number& self, const number& other) {
+
+        if (self.is_nan() || other.is_nan()) {
+            return number::nan();
+        }
+
+        // The result takes the sign of the divisor.
+        switch (number::common_kind(self, other)) {
+
+        case number::integer_kind: {
+            auto a = self.integer();
+            auto b = other.integer();
+
+            if (b == 0) {
+                return number::nan();
+            }
+
+            if (b == -1) {
+                return number(0ll);
+            }
+
+            auto r = a % b;
+
+            if (r != 0 && ((r < 0) != (b < 0))) {
+                r += b;
+            }
+
+            return number(r);
+        }
+
+        case number::big_int_kind: {
+            auto a = self.to_big_int();
+            auto b = other.to_big_int();
+
+            if (b.is_zero()) {
+                return number::nan();
+            }
+
+            number::big_int q;
+            number::big_int r;
+
+            big_divide(a, b, q, r);
+
+            if (!r.is_zero() && ((r.sign() < 0) != (b.sign() < 0))) {
+                r += b;
+            }
+
+            return number::normalize(std::move(r));
+        }
+
+        case number::rational_kind:
+        case number::big_rational_kind:
+        case number::decimal_kind:
+            return _is_(other) ? number::divide_exact(self, other, number::floor, true) : number::nan();
+
+        case number::big_float_kind: {
+            auto a = self.to_big_float();
+            auto b = other.to_big_float();
+
+            if (b.is_zero()) {
+                return number::nan();
+            }
+
+            number::big_float r = boost::multiprecision::fmod(a, b);
+
+            if (!r.is_zero() && ((r.sign() < 0) != (b.sign() < 0))) {
+                r += b;
+            }
+
+            return number(std::move(r));
+        }
+
+        case number::complex_kind:
+            return number::nan();
+
+        default:
+            break;
+        }
+
+        auto x = self.to_real();
+        auto y = other.to_real();
+
+        if (y == 0) {
+            return number::nan();
+        }
+
+        auto r = std::fmod(x, y);
+
+        if (r != 0 && ((r < 0) != (y < 0))) {
+            r += y;
+        }
+
+        return number::from_real(r);
+    }
+
+    var _neg_(number& self) {
+
+        if (self.is_nan()) {
+            return number::nan();
+        }
+
+        switch (self.type()) {
+
+        case number::integer_kind:
+            if (self.integer() != std::numeric_limits<number::int_type>::min()) {
+                return number(-self.integer());
+            }
+            [[fallthrough]];
+
+        case number::big_int_kind:
+            return number::normalize(-self.to_big_int());
+
+        case number::rational_kind: {
+            auto x = self.as_ratio();
+
+            if (x.num != std::numeric_limits<number::int_type>::min()) {
+                return number(number::ratio_type{ -x.num, x.den });
+            }
+            [[fallthrough]];
+        }
+
+        case number::big_rational_kind:
+            return number::normalize(number::big_rational(-self.to_big_rational()));
+
+        case number::decimal_kind: {
+            auto x = self.as_decimal();
+
+            if (x.coef != std::numeric_limits<number::int_type>::min()) {
+                return number(number::decimal_type{ -x.coef, x.scale });
+            }
+            return number::normalize(number::big_rational(-self.to_big_rational()));
+        }
+
+        case number::big_float_kind:
+            return number(number::big_float(-self.to_big_float()));
+
+        case number::real_kind:
+            return number::from_real(-self.to_real());
+
+        default:
+            return number(-self.to_complex());
+        }
+    }
+
+    var _f_div_(number& self, const var& other) {
+
+        auto ptr = other.cast<number>();
+
+        if (!ptr) {
+            return var();
+        }
+
+        return _f_div_(std::as_const(self), *ptr);
+    }
+
+    var _rem_(number& self, const var& other) {
+
+        auto ptr = other.cast<number>();
+
+        if (!ptr) {
+            return var();
+        }
+
+        return _rem_(std::as_const(self), *ptr);
+    }
+
+    var _f_div_(const number& self, const number& other) {
+
+        if (self.is_nan() || other.is_nan()) {
+            return number::nan();
+        }
+
+        // The quotient is rounded toward negative infinity, and is exact for
+        // integers and rationals.
+        switch (number::common_kind(self, other)) {
+
+        case number::complex_kind:
+            return number::nan();
+
+        case number::big_float_kind: {
+            auto b = other.to_big_float();
+
+            if (b.is_zero()) {
+                return number::nan();
+            }
+
+            return number(number::big_float(boost::multiprecision::floor(number::big_float(self.to_big_float() / b))));
+        }
+
+        case number::real_kind: {
+            auto y = other.to_real();
+
+            if (y == 0) {
+                return number::nan();
+            }
+
+            return number::from_real(std::floor(self.to_real() / y));
+        }
+
+        default:
+            break;
+        }
+
+        if (!_is_(other)) {
+            return number::nan();
+        }
+
+        return number::divide_exact(self, other, number::floor, false);
+    }
+
+    var _rem_(const number& self, const number& other) {
+
+        if (self.is_nan() || other.is_nan()) {
+            return number::nan();
+        }
+
+        // The remainder of a truncated division takes the sign of the dividend.
+        switch (number::common_kind(self, other)) {
+
+        case number::complex_kind:
+            return number::nan();
+
+        case number::big_float_kind: {
+            auto b = other.to_big_float();
+
+            if (b.is_zero()) {
+                return number::nan();
+            }
+
+            return number(number::big_float(boost::multiprecision::fmod(self.to_big_float(), b)));
+        }
+
+        case number::real_kind: {
+            auto y = other.to_real();
+
+            if (y == 0) {
+                return number::nan();
+            }
+
+            return number::from_real(std::fmod(self.to_real(), y));
+        }
+
+        default:
+            break;
+        }
+
+        if (!_is_(other)) {
+            return number::nan();
+        }
+
+        return number::divide_exact(self, other, number::truncate, true);
+    }
+
+    var _pow_(number& self, const var& other) {
+
+        auto ptr = other.cast<number>();
+
+        if (!ptr) {
+            return var();
+        }
+
+        return _pow_(std::as_const(self), *ptr);
+    }
+
+    var _pow_(const number& self, const number& other) {
+
+        if (self.is_nan() || other.is_nan()) {
+            return number::nan();
+        }
+
+        // Integers raised to a non-negative int64 are exact, by repeated squaring,
+        // unless the power would exceed 'OLIVER_MAX_POWER_BITS'.
+        if (self.is_integral() && other.type() == number::integer_kind && other.integer() >= 0) {
+
+            auto e = static_cast<std::uint64_t>(other.integer());
+
+            if (self.type() == number::integer_kind) {
+
+                number::int_type base   = self.integer();
+                number::int_type result = 1;
+
+                while (true) {
+
+                    if ((e & 1) && number::mul_overflow(result, base, result)) {
+                        break;
+                    }
+
+                    e >>= 1;
+
+                    if (!e) {
+                        return number(result);
+                    }
+
+                    if (number::mul_overflow(base, base, base)) {
+                        break;
+                    }
+                }
+
+                e = static_cast<std::uint64_t>(other.integer());
+            }
+
+            auto b = self.to_big_int();
+
+            if (big_power_fits(b, e)) {
+                return number::normalize(big_power(std::move(b), e));
+            }
+        }
+
+        // A decimal raised to a non-negative integer stays a decimal while it fits.
+        if (self.type() == number::decimal_kind && other.type() == number::integer_kind && other.integer() >= 0) {
+
+            auto x = self.as_decimal();
+            auto e = other.integer();
+
+            number::int_type coef = 1;
+
+            bool fits = x.scale == 0 || e <= number::max_scale / x.scale;
+
+            for (auto n = e; fits && n; n >>= 1) {
+
+                if (n & 1) {
+                    fits = !number::mul_overflow(coef, x.coef, coef);
+                }
+
+                if (fits && n > 1) {
+                    fits = !number::mul_overflow(x.coef, x.coef, x.coef);
+                }
+            }
+
+            if (fits) {
+                return number(number::decimal_type{ coef, static_cast<std::uint8_t>(x.scale * e) });
+            }
+        }
+
+        // A rational raised to an integer stays exact, the power of each part.
+        // Zero has no reciprocal, so it is raised to a negative power as a real.
+        if ((self.type() == number::rational_kind || self.type() == number::decimal_kind || self.type() == number::big_rational_kind) && other.type() == number::integer_kind
+            && (_is_(self) || other.integer() >= 0)) {
+
+            auto i = other.integer();
+            auto e = i < 0 ? 0 - static_cast<std::uint64_t>(i) : static_cast<std::uint64_t>(i);
+
+            auto x = self.to_big_rational();
+
+            number::big_int n = boost::multiprecision::numerator(x);
+            number::big_int d = boost::multiprecision::denominator(x);
+
+            if (big_power_fits(n, e) && big_power_fits(d, e)) {
+
+                n = big_power(std::move(n), e);
+                d = big_power(std::move(d), e);
+
+                return number::normalize(i < 0 ? number::big_rational(d, n) : number::big_rational(n, d));
+            }
+        }
+
+        const auto k = number::common_kind(self, other);
+
+        if (k == number::big_float_kind) {
+            return number(number::big_float(boost::multiprecision::pow(self.to_big_float(), other.to_big_float())));
+        }
+
+        if (k != number::complex_kind) {
+
+            auto x = self.to_real();
+            auto y = other.to_real();
+
+            // Only a negative base raised to a fractional power has a complex result.
+            if (x >= 0 || y == std::trunc(y)) {
+                return number::from_real(std::pow(x, y));
+            }
+        }
+
+        return number(std::pow(self.to_complex(), other.to_complex()));
+    }
+
+    /*
+        An integer root of an integer is exact, when there is one.  Otherwise
+        a root is the power of the reciprocal.  Only an odd root of a negative
+        real is real, any other root of a negative is complex.
+    */
+    var _root_(const number& self, const var& other) {
+
+        auto ptr = other.cast<number>();
+
+        if (!ptr) {
+            return var();
+        }
+
+        const number& n = *ptr;
+
+        if (self.is_nan() || n.is_nan() || !_is_(n)) {
+            return number::nan();
+        }
+
+        if (n.type() == number::integer_kind && n.integer() == 1) {
+            return self;
+        }
+
+        const bool odd = n.type() == number::integer_kind && (n.integer() & 1);
+
+        if (self.type() == number::integer_kind && n.type() == number::integer_kind && n.integer() > 0 && (odd || !self.is_negative())) {
+
+            const number::int_type x = self.integer();
+            const number::int_type k = n.integer();
+            const std::uint64_t    m = x < 0 ? 0 - static_cast<std::uint64_t>(x) : static_cast<std::uint64_t>(x);
+
+            // The rounded root of a double is within one of the exact root.
+            const auto guess = static_cast<std::uint64_t>(std::llround(std::pow(static_cast<double>(m), 1.0 / static_cast<double>(k))));
+
+            for (std::uint64_t r = guess > 0 ? guess - 1 : 0; r <= guess + 1; ++r) {
+
+                std::uint64_t p = r > 1 ? 1 : r;
+
+                for (number::int_type i = 0; r > 1 && i < k && p <= m; ++i) {
+                    p = p > m / r ? m + 1 : p * r;
+                }
+
+                if (p == m) {
+                    const auto root = static_cast<number::int_type>(r);
+                    return number(static_cast<long long>(x < 0 ? -root : root));
+                }
+            }
+        }
+
+        if (odd && self.type() != number::complex_kind && self.is_negative()) {
+
+            var    neg = _neg_(self);
+            number x   = *neg.cast<number>();
+
+            var root = _root_(x, other);
+
+            return -root;
+        }
+
+        number reciprocal;
+
+        if (n.type() == number::complex_kind) {
+            reciprocal = number(1.0 / n.to_complex());
+        }
+        else if (n.type() == number::big_float_kind || self.type() == number::big_float_kind) {
+            reciprocal = number(number::big_float(1 / n.to_big_float()));
+        }
+        else {
+            reciprocal = number::from_real(1.0 / n.to_real());
+        }
+
+        return _pow_(std::as_const(self), reciprocal);
+    }
+
+    var _real_(const number& self) {
+
+        if (self.type() == number::complex_kind) {
+            return number::from_real(self.to_complex().real());
+        }
+
+        return self;
+    }
+
+    var _imag_(const number& self) {
+
+        if (self.type() == number::complex_kind) {
+            return number::from_real(self.to_complex().imag());
+        }
+
+        return number(0ll);
+    }
+
+    var _abs_(const number& self) {
+
+        switch (self.type()) {
+
+        case number::complex_kind:
+            return number::from_real(std::abs(self.to_complex()));
+
+        case number::real_kind:
+            return number::from_real(std::fabs(self.to_real()));
+
+        default:
+            if (self.is_negative()) {
+                return _neg_(self);
+            }
+            return self;
+        }
+    }
+
+    var _exp_(const number& self) {
+        return number::elementary(self, [](const auto& x) { using std::exp; return exp(x); });
+    }
+
+    // The logarithm of a negative real is complex.
+    var _log_(const number& self) {
+
+        if (self.is_negative()) {
+            return number(std::log(self.to_complex()));
+        }
+
+        return number::elementary(self, [](const auto& x) { using std::log; return log(x); });
+    }
+
+    var _sin_(const number& self) {
+        return number::elementary(self, [](const auto& x) { using std::sin; return sin(x); });
+    }
+
+    var _cos_(const number& self) {
+        return number::elementary(self, [](const auto& x) { using std::cos; return cos(x); });
+    }
+
+    var _tan_(const number& self) {
+        return number::elementary(self, [](const auto& x) { using std::tan; return tan(x); });
+    }
+
+    var _sinh_(const number& self) {
+        return number::elementary(self, [](const auto& x) { using std::sinh; return sinh(x); });
+    }
+
+    var _cosh_(const number& self) {
+        return number::elementary(self, [](const auto& x) { using std::cosh; return cosh(x); });
+    }
 
-        return var();
+    var _tanh_(const number& self) {
+        return number::elementary(self, [](const auto& x) { using std::tanh; return tanh(x); });
     }
-}
\ No newline at end of file
+}
@@ -29,6 +29,7 @@
 
 #include "Var.h"
 #include "Boolean.h"
+#include "MemoryResource.h"
 #include "Function.h"
 #include "Number.h"
 #include "Text.h"
@@ -47,13 +48,18 @@ namespace Oliver {
 
     class object {
 
-        std::map<std::string, var> _map;
-        std::string                                  _type;
+        std::pmr::map<std::pmr::string, var, std::less<>> _map;
+        std::string                                        _type;
 
     public:
 
         object();
         object(var terms);
+        object(const object& other);
+        object(object&& other)                 = default;
+
+        object& operator=(const object& other) = default;
+        object& operator=(object&& other)      = default;
 
         friend std::string          _type_(const object& self);
         friend std::size_t     _size_type_(const object& self);
@@ -63,14 +69,25 @@ namespace Oliver {
         friend bool             _is_object(const object& self);
 
         friend std::string           _str_(const object& self, const Format_Args& fmt);
+        friend void                _write_(const object& self, fmt::memory_buffer& out, const Format_Args& fmt);
+
+        friend var                  _set_(object& self, const var& index, const var& other);
+        friend var                  _set_(object& self, const var& index, var&& other);
+        friend var                  _del_(object& self, const var& index);
+        friend var                  _get_(const object& self, const var& index);
+        friend var                  _has_(const object& self, const var& index);
+
+        friend var                  _sub_(object& self, const var& index);
+        friend var                  _mod_(object& self, const var& index);
 
-        friend var                  _set_(object& self, var& index, var& other);
-        friend var                  _del_(object& self, var& index);
-        friend var                  _get_(object& self, var& index);
-        friend var                  _has_(object& self, var& index);
+    private:
 
-        friend var                  _sub_(object& self, var& index);
-        friend var                  _mod_(object& self, var& index);
+        std::pmr::string make_key(std::string_view str) const;  // A key allocated from the map's resource.
+    };
+
+    template<>
+    struct shared_payload<object> {
+        static constexpr bool value = true;
     };
 
     /********************************************************************************************/
@@ -79,21 +96,26 @@ namespace Oliver {
     //
     /********************************************************************************************/
 
-    object::object() : _map{}, _type{ "object" } {
+    object::object() : _map(current_resource()), _type{ "object" } {
+    }
+
+    object::object(const object& other) : _map(other._map, current_resource()), _type(other._type) {
     }
 
-    object::object(var terms) : _map{}, _type{ "object" } {
+    object::object(var terms) : _map(current_resource()), _type{ "object" } {
 
         while (terms) {
             var val = terms.lead();
+            terms   = terms.drop();
             var key = terms.lead();
+            terms   = terms.drop();
 
             if (key.is_something()) {
                 if (auto str = key.str(Format_Args{}); str == "type") {
                     _type = val.lead().str(Format_Args{});
                 }
                 else {
-                    _map[str] = val;
+                    _map[make_key(str)] = val;
                 }
             }
         }
@@ -131,33 +153,49 @@ namespace Oliver {
 
     std::string _str_(const object& self, const Format_Args& fmt) {
 
-        if (!_is_(self)) {
-            return "{}"s;
-        }
+        fmt::memory_buffer buffer;
+
+        _write_(self, buffer, fmt);
+
+        return fmt::to_string(buffer);
+    }
+
+    void _write_(const object& self, fmt::memory_buffer& out, const Format_Args& fmt) {
 
-        std::string result = "{"s;
+        out.push_back('{');
 
         for (auto i = self._map.begin(); i != self._map.end(); ++i) {
-            result = fmt::format("{}{}:{}; ", result, i->first, i->second.str(fmt));
+
+            if (i != self._map.begin()) {
+                out.push_back(' ');
+            }
+
+            out.append(i->first.data(), i->first.data() + i->first.size());
+            out.push_back(':');
+            i->second.write(out, fmt);
+            out.push_back(';');
         }
-        result.pop_back();
-        result += "}"s;
 
-        return result;
+        out.push_back('}');
+    }
+
+    var _set_(object& self, const var& index, const var& other) {
+
+        return _set_(self, index, var(other));
     }
 
-    var _set_(object& self, var& index, var& other) {
+    var _set_(object& self, const var& index, var&& other) {
 
         if (index.is_nothing() || other.is_nothing()) {
             return std::move(self);
         }
 
-        if (index.type() == "list") {
+        if (index.is<list>()) {
             switch (index.size_type()) {
 
             case 1:
-                index = index.lead();
-                self._map[index.str(Format_Args{})] = other;
+                var key = var(index).lead();
+                self._map[self.make_key(key.str(Format_Args{}))] = std::move(other);
                 return std::move(self);
 
             }
@@ -165,54 +203,60 @@ namespace Oliver {
         return error(fmt::format("Invalid index - {} - provided!", index));
     }
 
-    var _del_(object& self, var& index) {
+    var _del_(object& self, const var& index) {
 
         if (index.is_nothing()) {
             return std::move(self);
         }
 
-        self._map.erase(index.lead().str(Format_Args{}));
+        if (auto i = self._map.find(std::string_view(var(index).lead().str(Format_Args{}))); i != self._map.end()) {
+            self._map.erase(i);
+        }
 
         return std::move(self);
     }
 
-    var _get_(object& self, var& index) {
+    var _get_(const object& self, const var& index) {
 
         if (index.is_nothing()) {
-            return std::move(self);
+            return self;
         }
 
-        if (index.type() == "list") {
+        if (index.is<list>()) {
             switch (index.size_type()) {
 
                 case 1:
-                    index = index.lead();
-                    return self._map[index.str(Format_Args{})];
+                    auto i = self._map.find(std::string_view(var(index).lead().str(Format_Args{})));
+                    return i != self._map.end() ? i->second : var();
 
             }
         }
         return error(fmt::format("Invalid index - {} - provided!", index));
     }
 
-    var _has_(object& self, var& index) {
+    var _has_(const object& self, const var& index) {
 
         if (index.is_nothing()) {
-            return std::move(self);
+            return self;
         }
 
-        if (self._map.contains(index.lead().str(Format_Args{}))) {
+        if (self._map.contains(std::string_view(var(index).lead().str(Format_Args{})))) {
             return boolean(true);
         }
 
         return boolean(false);
     }
 
-    var _sub_(object& self, var& index) {
+    std::pmr::string object::make_key(std::string_view str) const {
+        return std::pmr::string(str, _map.get_allocator());
+    }
+
+    var _sub_(object& self, const var& index) {
 
         return _del_(self, index);
     }
 
-    var _mod_(object& self, var& index) {
+    var _mod_(object& self, const var& index) {
 
         return _has_(self, index);
     }
@@ -45,7 +45,7 @@ namespace Oliver {
     public:
 
         op_call(op_code val);
-        op_call(std::string str);
+        op_call(std::string_view str);
 
         friend bool                  _is_(const op_call& self);
         friend std::string         _type_(const op_call& self);
@@ -58,14 +58,7 @@ namespace Oliver {
     op_call::op_call(op_code val) : _value(val) {
     }
 
-    op_call::op_call(std::string str) : _value(op_code::nothing_op) {
-
-        auto it = operators.find(str);
-
-        if (it != operators.end()) {
-
-            _value = it->second;
-        }
+    op_call::op_call(std::string_view str) : _value(find_operator(str)) {
     }
 
     bool _is_(const op_call& self) {
@@ -99,13 +92,9 @@ namespace Oliver {
 
     std::string _str_(const op_call& self, const Format_Args& fmt) {
 
-        for (auto it = operators.cbegin(); it != operators.cend(); ++it) {
+        const std::string_view name = operator_name(self._value);
 
-            if (it->second == self._value) {
-                return it->first;
-            }
-        }
-        return "unknown_operator"s;
+        return name.empty() ? "unknown_operator"s : std::string(name);
     }
 
     op_code _op_call_(const op_call& self) {
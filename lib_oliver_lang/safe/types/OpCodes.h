@@ -24,8 +24,14 @@
 //
 /*****************************************************************************************/
 
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <map>
-#include "boost/container/flat_map.hpp"
+#include <stdexcept>
+#include <string_view>
+#include <utility>
 
 namespace Oliver {
 
@@ -109,10 +115,12 @@ namespace Oliver {
     //
     //                                 Interpreter Operator Map
     //
+    //          Each spelling of an operator, and its code.  A code may have more than
+    //          one spelling, the first in lexical order is its name.
+    //
     /********************************************************************************************/
 
-    //static const std::map<std::string, op_code> operators = {
-    static const boost::container::flat_map<std::string, op_code> operators = {
+    inline constexpr auto operator_spellings = std::to_array<std::pair<std::string_view, op_code>>({
 
         // Shebang Operators
         { "#!",              op_code::shebang_op },    { "NO_EXCEPT",     op_code::no_except_op },
@@ -178,7 +186,6 @@ namespace Oliver {
 
         // TODO: sort below operations
 
-        { "size",               op_code::size_op },    { "size",               op_code::size_op },
 
 
         // print, str, repr, ...
@@ -206,6 +213,159 @@ namespace Oliver {
 
 
 
+    });
+
+    /********************************************************************************************/
+    //
+    //                                 Interpreter Operator Lookup
+    //
+    //          'find_operator' maps a spelling to its code through a perfect hash,
+    //          built at compile time by hash and displace.  The spellings are split
+    //          into buckets by one hash, then each bucket, largest first, is given
+    //          the first seed, of 256, which sends all of its spellings to free slots.
+    //          So a lookup is two hashes, and a single comparison to reject a miss.
+    //
+    //          'operator_name' indexes a dense array of the name of each code.
+    //
+    /********************************************************************************************/
+
+    constexpr std::uint64_t operator_hash(std::string_view str, std::uint64_t seed) noexcept {
+
+        std::uint64_t h = 0xcbf29ce484222325ull ^ (seed * 0x9e3779b97f4a7c15ull);  // FNV-1a, seeded.
+
+        for (char c : str) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 0x100000001b3ull;
+        }
+
+        return h ^ (h >> 29);
+    }
+
+    struct operator_table {
+
+        static constexpr std::size_t   count       = operator_spellings.size();
+        static constexpr std::size_t   slots       = std::bit_ceil(2 * count);
+        static constexpr std::size_t   buckets     = std::bit_ceil(count / 4);
+        static constexpr std::uint8_t  empty       = 0xFF;
+        static constexpr std::uint32_t seeds_tried = 256;  // For each bucket, before the build fails.
+
+        static_assert(count < empty, "operator_table: entries are indexed by a byte");
+
+        std::array<std::uint32_t, buckets>                                            seeds{};
+        std::array<std::uint8_t, slots>                                               entries{};
+        std::array<std::string_view, static_cast<std::size_t>(op_code::END_OPERATORS)> names{};
+
+        static constexpr std::size_t bucket(std::string_view str) noexcept {
+            return operator_hash(str, 0) & (buckets - 1);
+        }
+
+        static constexpr std::size_t slot(std::string_view str, std::uint32_t seed) noexcept {
+            return operator_hash(str, seed) & (slots - 1);
+        }
     };
 
+    consteval operator_table make_operator_table() {
+
+        operator_table t;
+
+        t.entries.fill(operator_table::empty);
+
+        std::array<std::size_t, operator_table::buckets> sizes{};
+        std::array<std::size_t, operator_table::buckets> order{};
+
+        for (std::size_t i = 0; i < operator_table::count; ++i) {
+
+            const auto& [str, code] = operator_spellings[i];
+
+            for (std::size_t j = 0; j < i; ++j) {
+                if (operator_spellings[j].first == str) {
+                    throw std::logic_error("operator_table: duplicate spelling");
+                }
+            }
+
+            ++sizes[operator_table::bucket(str)];
+
+            auto& name = t.names[static_cast<std::size_t>(code)];
+
+            if (name.empty() || str < name) {
+                name = str;
+            }
+        }
+
+        for (std::size_t b = 0; b < operator_table::buckets; ++b) {
+            order[b] = b;
+        }
+
+        for (std::size_t i = 0; i < operator_table::buckets; ++i) {  // Largest bucket first.
+            for (std::size_t j = i + 1; j < operator_table::buckets; ++j) {
+                if (sizes[order[j]] > sizes[order[i]]) {
+                    std::swap(order[i], order[j]);
+                }
+            }
+        }
+
+        for (std::size_t b : order) {
+
+            if (!sizes[b]) {
+                break;
+            }
+
+            for (std::uint32_t seed = 1;; ++seed) {
+
+                if (seed > operator_table::seeds_tried) {
+                    throw std::logic_error("operator_table: no seed found");
+                }
+
+                std::array<std::uint8_t, operator_table::slots> trial = t.entries;
+
+                bool placed = true;
+
+                for (std::size_t i = 0; i < operator_table::count && placed; ++i) {
+
+                    const std::string_view str = operator_spellings[i].first;
+
+                    if (operator_table::bucket(str) != b) {
+                        continue;
+                    }
+
+                    auto& entry = trial[operator_table::slot(str, seed)];
+
+                    placed = entry == operator_table::empty;
+                    entry  = static_cast<std::uint8_t>(i);
+                }
+
+                if (placed) {
+                    t.seeds[b] = seed;
+                    t.entries  = trial;
+                    break;
+                }
+            }
+        }
+
+        return t;
+    }
+
+    inline constexpr operator_table operators = make_operator_table();
+
+    constexpr op_code find_operator(std::string_view str) noexcept {
+
+        const std::uint8_t i = operators.entries[operator_table::slot(str, operators.seeds[operator_table::bucket(str)])];
+
+        if (i != operator_table::empty && operator_spellings[i].first == str) {
+            return operator_spellings[i].second;
+        }
+
+        return op_code::nothing_op;
+    }
+
+    constexpr std::string_view operator_name(op_code code) noexcept {
+
+        const auto i = static_cast<std::size_t>(code);
+
+        return i < operators.names.size() ? operators.names[i] : std::string_view();
+    }
+
+    static_assert(find_operator("+") == op_code::ADD_op && find_operator("<->") == op_code::JOIN_op);
+    static_assert(find_operator("bool_numeric") == op_code::bool_numeric_op && find_operator("++") == op_code::nothing_op);
+    static_assert(operator_name(op_code::nothing_op) == "none" && operator_name(op_code::rev_op) == "rev");
 }
@@ -25,6 +25,7 @@
 /*****************************************************************************************/
 
 #include "Var.h"
+#include "SymbolTable.h"
 
 namespace Oliver {
 
@@ -35,35 +36,54 @@ namespace Oliver {
     //        The symbol class defines a variable instance which exists within
     //        variable environment of the program.  
     //
+    //        A symbol holds only the id of its name in the 'symbol_table'.  So two
+    //        symbols are equal exactly when their ids are, and an environment may
+    //        be keyed on the id.  The name itself is looked up only to order or
+    //        print the symbol.
+    //
     /********************************************************************************************/
 
 
     class symbol {
 
-        std::string _value;
+        symbol_table::id_type _id;
 
     public:
 
         symbol();
-        symbol(std::string str);
+        symbol(std::string_view str);
+
+        symbol_table::id_type     id() const noexcept;
+        std::string_view        name() const noexcept;
 
         friend bool           _is_(const symbol& self);
         friend std::string  _type_(const symbol& self);
         friend order        _comp_(const symbol& self, const var& other);
+        friend order        _comp_(const symbol& self, const symbol& other);  // Typed kernel, used by the 'infix_table'.
         friend std::string   _str_(const symbol& self, const Format_Args& fmt);
 
         friend std::string     _help_(const symbol& self);
+
+        friend class value;
     };
 
 
-    symbol::symbol() : _value("") {
+    symbol::symbol() : _id(0) {
+    }
+
+    symbol::symbol(std::string_view str) : _id(symbol_table::intern(str)) {
+    }
+
+    symbol_table::id_type symbol::id() const noexcept {
+        return _id;
     }
 
-    symbol::symbol(std::string str) : _value(str) {
+    std::string_view symbol::name() const noexcept {
+        return symbol_table::name(_id);
     }
 
     bool _is_(const symbol& self) {
-        return !self._value.empty();
+        return self._id != 0;
     }
 
     std::string _type_(const symbol& self) {
@@ -75,20 +95,22 @@ namespace Oliver {
         const symbol* s = other.cast<symbol>();
 
         if (s) {
-            if (self._value > s->_value) {
-                return order::greater;
-            }
-            if (self._value < s->_value) {
-                return order::less;
-            }
-            return order::equivalent;
+            return _comp_(self, *s);
         }
 
         return order::unordered;
     }
 
+    order _comp_(const symbol& self, const symbol& other) {
+
+        if (self._id == other._id) {
+            return order::equivalent;
+        }
+        return self.name() > other.name() ? order::greater : order::less;
+    }
+
     std::string _str_(const symbol& self, const Format_Args& fmt) {
-        return self._value;
+        return std::string(self.name());
     }
 
     std::string _help_(const symbol& self) {
@@ -0,0 +1,166 @@
+#pragma once
+
+/*****************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//        This program is free software : you can redistribute it and /or modify
+//        it under the terms of the GNU Affero General Public License as published by
+//        the Free Software Foundation, either version 3 of the License, or
+//        (at your option) any later version.
+//
+//        This program is distributed in the hope that it will be useful,
+//        but WITHOUT ANY WARRANTY; without even the implied warranty of
+//        MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//        GNU Affero General Public License for more details.
+//
+//        You should have received a copy of the GNU Affero General Public License
+//        along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//        The author can be reached at: maxjmartin@gmail.com
+//
+/*****************************************************************************************/
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Oliver {
+
+    /********************************************************************************************/
+    //
+    //                              'symbol_table' Class Definition
+    //
+    //          The symbol table interns the name of every symbol, giving each distinct
+    //          name a dense 32 bit id, in the order first seen.  The empty name is id 0.
+    //          Names are never removed, so an id is valid for the life of the program.
+    //
+    //          'intern' takes a shared lock to find a name, and an exclusive lock only
+    //          to add one.  'name' takes no lock, the names are held in fixed blocks
+    //          which never move, and a block is published before any id within it.
+    //
+    /********************************************************************************************/
+
+    class symbol_table {
+
+    public:
+
+        using id_type = std::uint32_t;
+
+        static constexpr std::size_t block_size  = 1024;
+        static constexpr std::size_t block_count = 4096;  // So at most 4 Mi distinct names.
+
+        static id_type              intern(std::string_view name);
+        static std::string_view       name(id_type id) noexcept;
+        static std::size_t            size()           noexcept;
+
+    private:
+
+        using block = std::array<std::string_view, block_size>;
+
+        struct tables {
+            std::shared_mutex                                 mutex;
+            std::pmr::monotonic_buffer_resource               names;  // The characters of every name.
+            std::unordered_map<std::string_view, id_type>     ids;
+            std::array<std::atomic<block*>, block_count>      blocks{};
+            std::atomic<std::size_t>                          size{0};
+
+            tables();
+            ~tables();
+        };
+
+        static tables& instance();
+    };
+
+    /********************************************************************************************/
+    //
+    //                              'symbol_table' Class Implementation
+    //
+    /********************************************************************************************/
+
+    inline symbol_table::tables::tables() {
+
+        blocks[0].store(new block{}, std::memory_order_relaxed);
+
+        ids.emplace(std::string_view(), 0);
+        size.store(1, std::memory_order_release);
+    }
+
+    inline symbol_table::tables::~tables() {
+
+        for (auto& b : blocks) {
+            delete b.load(std::memory_order_relaxed);
+        }
+    }
+
+    inline symbol_table::tables& symbol_table::instance() {
+        static tables t;
+        return t;
+    }
+
+    inline symbol_table::id_type symbol_table::intern(std::string_view name) {
+
+        tables& t = instance();
+
+        {
+            std::shared_lock lock(t.mutex);
+
+            auto i = t.ids.find(name);
+
+            if (i != t.ids.end()) {
+                return i->second;
+            }
+        }
+
+        std::unique_lock lock(t.mutex);
+
+        auto i = t.ids.find(name);  // Another thread may have added it meanwhile.
+
+        if (i != t.ids.end()) {
+            return i->second;
+        }
+
+        const std::size_t id = t.size.load(std::memory_order_relaxed);
+
+        if (id >= block_size * block_count) {
+            throw std::length_error("symbol_table: too many distinct symbols");
+        }
+
+        auto& slot = t.blocks[id / block_size];
+
+        if (!slot.load(std::memory_order_relaxed)) {
+            slot.store(new block{}, std::memory_order_release);
+        }
+
+        char* data = static_cast<char*>(t.names.allocate(name.size() ? name.size() : 1, 1));
+        std::char_traits<char>::copy(data, name.data(), name.size());
+
+        const std::string_view stored(data, name.size());
+
+        (*slot.load(std::memory_order_relaxed))[id % block_size] = stored;
+
+        t.ids.emplace(stored, static_cast<id_type>(id));
+        t.size.store(id + 1, std::memory_order_release);
+
+        return static_cast<id_type>(id);
+    }
+
+    inline std::string_view symbol_table::name(id_type id) noexcept {
+        return (*instance().blocks[id / block_size].load(std::memory_order_acquire))[id % block_size];
+    }
+
+    inline std::size_t symbol_table::size() noexcept {
+        return instance().size.load(std::memory_order_acquire);
+    }
+}
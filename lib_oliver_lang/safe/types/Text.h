@@ -24,9 +24,17 @@
 //
 /*****************************************************************************************/
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include "Var.h"
+#include "MemoryResource.h"
 #include "Number.h"
 
+#include "../../unsafe/Rope.h"
+#include "../../unsafe/Utf8.h"
+
 namespace Oliver {
 
 
@@ -34,44 +42,245 @@ namespace Oliver {
     //
     //                               'text' Class Definition
     //
-    //        The text class provides a wrapper around normal C++ texts.  Why
-    //        re-invent the wheel?
+    //        The text class holds its characters in a 'rope', so a push, a
+    //        concatenation, or taking a substring is O(log n) rather than a copy
+    //        of the whole string.  A text no larger than a rope chunk is a plain
+    //        string, and only becomes a tree once it grows past one.
+    //
+    //        Slicing a long text shares the buffers of its parent, as a range of
+    //        each piece.  So 'drop' and 'shift' copy no characters, and a slice only
+    //        has storage of its own once it is joined with another.  A slice no
+    //        larger than a chunk, such as a code point from 'lead' or 'get', is
+    //        copied instead, so it neither builds nodes nor keeps its parent alive.
+    //
+    //        A text is always valid UTF-8, and its elements are code points.  Input
+    //        is validated when a text is constructed, and each invalid byte is
+    //        replaced by U+FFFD.  The length, and the byte offset of every 128th
+    //        code point, are counted the first time either is needed, and kept
+    //        until the text is joined with another or reversed.  So 'abs' and 'get'
+    //        are O(1) amortized, rather than a scan from the start on each call.
+    //
+    //        The index is held atomically, as 'abs' and 'get' may build it on a text
+    //        which is shared by several vars.  Two threads may then both build it,
+    //        but each builds the same index.
     //
     /********************************************************************************************/
 
 
     class text {
 
-        std::string _value;
+        struct code_points;
+
+        rope                                                    _value;
+        mutable std::atomic<std::shared_ptr<const code_points>> _index;  // Built on demand, and shared by copies.
 
     public:
 
         text();
         text(std::string_view str);
+        text(const text& other);
+        text(text&& other) noexcept;
+
+        text& operator=(const text& other);
+        text& operator=(text&& other) noexcept;
+
+        rope::const_iterator begin() const;  // Iterates the bytes of the pieces in place.
+        rope::const_iterator   end() const noexcept;
 
         friend std::string _type_(const text& self);
         friend bool          _is_(const text& self);
         friend order       _comp_(const text& self, const var& other);
+        friend order       _comp_(const text& self, const text& other);  // Typed kernel, used by the 'infix_table'.
         friend std::string  _str_(const text& self, const Format_Args& fmt);
-
-        friend var          _abs_(text& self);
-        friend var         _lead_(text& self);
-        friend var         _push_(text& self, var& other);
+        friend void       _write_(const text& self, fmt::memory_buffer& out, const Format_Args& fmt);
+
+        friend var          _abs_(const text& self);
+        friend var          _add_(text& self, const var& other);
+        friend var         _lead_(const text& self);
+        friend var         _push_(text& self, const var& other);
+        friend var         _push_(text& self, var&& other);
+        friend var         _drop_(text& self);
+        friend var        _shift_(text& self);
         friend var      _reverse_(text& self);
+        friend var          _get_(const text& self, const var& index);
 
     private:
-        text(char c);
+
+        static constexpr std::size_t stride = 128;  // Code points between marks of the index.
+
+        struct code_points {
+            std::shared_ptr<const std::vector<std::size_t>> marks;  // The byte of every 'stride'th code point, when built.
+            std::size_t length;                                     // Code points in the text.
+            std::size_t first;                                      // Code points dropped since it was built.
+            std::size_t offset;                                     // Bytes dropped since it was built.
+        };
+
+        text(rope value);
+
+        std::shared_ptr<const code_points> index() const;
+        rope             code_point(std::size_t i) const;  // The 'i'th code point, which must exist.
+        std::size_t       lead_size() const;         // Bytes in the first code point.
+        void         drop_lead();
+        void            changed() noexcept;          // Discard the index.
     };
 
+    template<>
+    struct shared_payload<text> {
+        static constexpr bool value = true;
+    };
+
+
+    text::text() : _value(current_resource()) {
+    }
+
+    text::text(std::string_view str)
+        : _value(utf8_valid_prefix(str) == str.size() ? rope(str, current_resource()) : rope(utf8_repair(str), current_resource())) {
+    }
+
+    text::text(const text& other) : _value(current_resource()), _index(other._index.load(std::memory_order_acquire)) {
+        _value.append(other._value);  // Shares the nodes, unless 'other' is from another resource.
+    }
+
+    text::text(text&& other) noexcept : _value(std::move(other._value)), _index(other._index.exchange(nullptr)) {
+    }
+
+    text& text::operator=(const text& other) {
+
+        if (this != &other) {
+            _value = other._value;
+            _index.store(other._index.load(std::memory_order_acquire), std::memory_order_release);
+        }
+
+        return *this;
+    }
+
+    text& text::operator=(text&& other) noexcept {
+
+        if (this != &other) {
+            _value = std::move(other._value);
+            _index.store(other._index.exchange(nullptr), std::memory_order_release);
+        }
+
+        return *this;
+    }
+
+    text::text(rope value) : _value(std::move(value)) {
+    }
+
+    rope::const_iterator text::begin() const {
+        return _value.begin();
+    }
 
-    text::text() : _value("") {
+    rope::const_iterator text::end() const noexcept {
+        return _value.end();
     }
 
-    text::text(std::string_view str) : _value(str) {
+    /*
+        Counts the code points of each piece a block at a time, only examining
+        bytes individually within a block which holds the next mark.
+    */
+    std::shared_ptr<const text::code_points> text::index() const {
+
+        if (auto x = _index.load(std::memory_order_acquire)) {
+            return x;
+        }
+
+        auto marks = std::make_shared<std::vector<std::size_t>>();
+
+        std::size_t bytes = 0;
+        std::size_t count = 0;
+        std::size_t next  = 0;  // The code point of the next mark.
+
+        _value.for_each_chunk([&](std::string_view s) {
+
+            std::size_t i = 0;
+
+            while (i < s.size()) {
+
+                const std::size_t end = std::min(i + utf8_block, s.size());
+
+                if (end - i == utf8_block) {
+
+                    const std::size_t n = utf8_block_count(s.data() + i);
+
+                    if (count + n <= next) {
+                        count += n;
+                        i      = end;
+                        continue;
+                    }
+                }
+
+                for (; i < end; ++i) {
+
+                    if (utf8_is_continuation(s[i])) {
+                        continue;
+                    }
+
+                    if (count == next) {
+                        marks->push_back(bytes + i);
+                        next += stride;
+                    }
+
+                    ++count;
+                }
+            }
+
+            bytes += s.size();
+        });
+
+        auto x = std::make_shared<const code_points>(code_points{ std::move(marks), count, 0, 0 });
+
+        _index.store(x, std::memory_order_release);
+
+        return x;
+    }
+
+    rope text::code_point(std::size_t i) const {
+
+        const auto         idx = index();
+        const code_points& x   = *idx;
+
+        const std::size_t k    = x.first + i;
+        const std::size_t mark = (*x.marks)[k / stride];
+
+        // The mark may precede the first code point, when some have been dropped.
+        std::size_t byte = mark >= x.offset ? mark - x.offset : 0;
+        std::size_t skip = mark >= x.offset ? k % stride : i;
+
+        if (skip) {
+
+            rope span = _value.substr(byte, 4 * skip + 4);
+
+            for (char c : span) {
+
+                if (!utf8_is_continuation(c) && !skip--) {
+                    break;
+                }
+
+                ++byte;
+            }
+        }
+
+        return _value.substr(byte, utf8_sequence_length(_value.at(byte)));
     }
 
-    text::text(char c) : _value("") {
-        _value = c;
+    std::size_t text::lead_size() const {
+        return utf8_sequence_length(_value.at(0));
+    }
+
+    void text::drop_lead() {
+
+        const std::size_t n = lead_size();
+
+        _value = _value.substr(n);
+
+        if (auto x = _index.load(std::memory_order_acquire)) {
+            _index.store(std::make_shared<const code_points>(code_points{ x->marks, x->length - 1, x->first + 1, x->offset + n }), std::memory_order_release);
+        }
+    }
+
+    void text::changed() noexcept {
+        _index.store(nullptr, std::memory_order_release);
     }
 
     std::string _type_(const text& self) {
@@ -87,40 +296,66 @@ namespace Oliver {
         const text* s = other.cast<text>();
 
         if (s) {
+            return _comp_(self, *s);
+        }
+        return order::unordered;
+    }
 
-            if (self._value > s->_value) {
-                return order::greater;
-            }
+    order _comp_(const text& self, const text& other) {
 
-            if (self._value < s->_value) {
-                return order::less;
-            }
+        const int c = self._value.compare(other._value);  // Byte order is code point order, in UTF-8.
 
-            return order::equivalent;
+        if (c > 0) {
+            return order::greater;
         }
-        return order::unordered;
+
+        if (c < 0) {
+            return order::less;
+        }
+
+        return order::equivalent;
     }
 
     std::string _str_(const text& self, const Format_Args& fmt) {
         // fmt::println("\n{}\n", fmt.print());
-        return self._value;
+        return self._value.str();
     }
 
-    var _abs_(text& self) {
-        return number(self._value.size());
+    void _write_(const text& self, fmt::memory_buffer& out, const Format_Args& fmt) {
+        self._value.for_each_chunk([&](std::string_view s) { out.append(s.data(), s.data() + s.size()); });
     }
 
-    var _lead_(text& self) {
-        return self._value.empty() ? var() : text(self._value.front());
+    var _abs_(const text& self) {
+        return number(static_cast<long long>(self.index()->length));
     }
 
-    var _push_(text& self, var& other) {
+    var _add_(text& self, const var& other) {
 
         const text* s = other.cast<text>();
 
         if (s) {
 
-            self._value = s->_value + self._value;
+            self._value.append(s->_value);
+            self.changed();
+
+            return std::move(self);
+        }
+
+        return var();
+    }
+
+    var _lead_(const text& self) {
+        return self._value.empty() ? var() : text(self._value.substr(0, self.lead_size()));
+    }
+
+    var _push_(text& self, const var& other) {
+
+        const text* s = other.cast<text>();
+
+        if (s) {
+
+            self._value.prepend(s->_value);
+            self.changed();
 
             return std::move(self);
         }
@@ -128,9 +363,76 @@ namespace Oliver {
         return nothing();
     }
 
+    var _push_(text& self, var&& other) {
+
+        auto s = other.move<text>();
+
+        if (s) {
+
+            s->_value.append(self._value);  // Join onto the temporary's tree.
+
+            self._value = std::move(s->_value);
+            self.changed();
+
+            return std::move(self);
+        }
+
+        return nothing();
+    }
+
+    var _drop_(text& self) {
+
+        if (!self._value.empty()) {
+            self.drop_lead();
+        }
+
+        return std::move(self);
+    }
+
+    var _shift_(text& self) {
+
+        if (!self._value.empty()) {
+            var a = text(self._value.substr(0, self.lead_size()));
+            self.drop_lead();
+            return make_pair(a, self);
+        }
+
+        return std::move(self);
+    }
+
+    var _get_(const text& self, const var& index) {
+
+        if (!index.is<number>()) {
+            return var();
+        }
+
+        const std::int64_t i = index.integer_type();
+
+        if (i >= 0 && static_cast<std::size_t>(i) < self.index()->length) {
+            return text(self.code_point(static_cast<std::size_t>(i)));
+        }
+
+        return var();
+    }
+
     var _reverse_(text& self) {
 
-        std::reverse(self._value.begin(), self._value.end());
+        const std::string str = self._value.str();
+
+        std::string result(str.size(), '\0');
+
+        // Copy each sequence whole, to the mirrored position.
+        for (std::size_t i = 0; i < str.size();) {
+
+            const std::size_t n = utf8_sequence_length(str[i]);
+
+            std::copy_n(str.data() + i, n, result.data() + str.size() - i - n);
+
+            i += n;
+        }
+
+        self._value = rope(result, self._value.resource());
+        self.changed();
 
         return std::move(self);
     }
@@ -0,0 +1,107 @@
+#pragma once
+
+/*****************************************************************************************/
+//
+//                           Copyright(C) 2023 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter. 
+//    
+//        This program is free software : you can redistribute it and /or modify
+//        it under the terms of the GNU Affero General Public License as published by
+//        the Free Software Foundation, either version 3 of the License, or
+//        (at your option) any later version.
+//    
+//        This program is distributed in the hope that it will be useful,
+//        but WITHOUT ANY WARRANTY; without even the implied warranty of
+//        MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//        GNU Affero General Public License for more details.
+//    
+//        You should have received a copy of the GNU Affero General Public License
+//        along with this program.If not, see <https://www.gnu.org/licenses/>.
+//    
+//        The author can be reached at: maxjmartin@gmail.com
+//
+/*****************************************************************************************/
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace Oliver {
+
+    /********************************************************************************************/
+    //
+    //                                 Interpreter Type Registry
+    //
+    //          Every type wrapped by a 'var' is given a dense integer id.  The types
+    //          listed in 'registered_types' are numbered at compile time, in the order
+    //          they are listed.  Any other type is numbered on first use, starting
+    //          after the last registered type.
+    //
+    //          The ids are used for internal dispatch, in place of comparing the
+    //          strings returned by '_type_'.  Which is kept only for display.
+    //
+    /********************************************************************************************/
+
+    class nothing;
+    class number;
+    class boolean;
+    class text;
+    class symbol;
+    class op_call;
+    class error;
+    class format;
+    class list;
+    class expression;
+    class object;
+
+    using type_id_t = std::uint32_t;
+
+    template<typename... Types>
+    struct type_list {
+        static constexpr type_id_t size = sizeof...(Types);
+    };
+
+    using registered_types = type_list<nothing, number, boolean, text, symbol, op_call, error, format, list, expression, object>;
+
+    template<typename T, typename... Types>
+    consteval type_id_t index_of(type_list<Types...>) {
+
+        type_id_t index = 0;
+        bool      found = false;
+
+        ((found = found || std::is_same_v<T, Types>, index += found ? 0 : 1), ...);
+
+        return index;
+    }
+
+    template<typename T>
+    constexpr bool is_registered_type = index_of<T>(registered_types{}) < registered_types::size;
+
+    inline type_id_t next_type_id() {
+        static std::atomic<type_id_t> next{ registered_types::size };
+        return next++;
+    }
+
+    // A function local static, so the id is assigned on first use, even during the
+    // static initialization of another translation unit.
+    template<typename T>
+    inline type_id_t runtime_type_id() {
+        static const type_id_t id = next_type_id();
+        return id;
+    }
+
+    template<typename T>
+    inline type_id_t type_id_of() {
+
+        using U = std::remove_cvref_t<T>;
+
+        if constexpr (is_registered_type<U>) {
+            return index_of<U>(registered_types{});
+        }
+        else {
+            return runtime_type_id<U>();
+        }
+    }
+}
@@ -0,0 +1,333 @@
+#pragma once
+
+/*****************************************************************************************/
+//
+//                           Copyright(C) 2023 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter. 
+//    
+//        This program is free software : you can redistribute it and /or modify
+//        it under the terms of the GNU Affero General Public License as published by
+//        the Free Software Foundation, either version 3 of the License, or
+//        (at your option) any later version.
+//    
+//        This program is distributed in the hope that it will be useful,
+//        but WITHOUT ANY WARRANTY; without even the implied warranty of
+//        MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//        GNU Affero General Public License for more details.
+//    
+//        You should have received a copy of the GNU Affero General Public License
+//        along with this program.If not, see <https://www.gnu.org/licenses/>.
+//    
+//        The author can be reached at: maxjmartin@gmail.com
+//
+/*****************************************************************************************/
+
+#include <bit>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <limits>
+#include <utility>
+
+#include "Var.h"
+#include "Boolean.h"
+#include "Number.h"
+#include "OpCall.h"
+#include "Symbol.h"
+
+namespace Oliver {
+
+    /********************************************************************************************/
+    //
+    //                                 'value' Class Definition
+    //
+    //        The value class is a compact, 8 byte, alternative to a 'var' for the
+    //        interpreter's hot scalars.  It NaN-boxes its contents:  a real number is
+    //        stored as its own double, while small integers, crisp booleans, op codes,
+    //        symbol ids and nothing are stored in the payload of a negative quiet NaN,
+    //        marked by the upper 16 bits.  Anything else is held as a pointer to a
+    //        boxed 'var'.
+    //
+    //        Every NaN is stored as the one canonical quiet NaN, so no real number can
+    //        be mistaken for a tagged value.
+    //
+    //        A boxed pointer must fit the 48 bit payload.  One with any of its upper
+    //        16 bits set, (such as from a 57 bit address space, or a tagged heap),
+    //        terminates the program, in every build, rather than being corrupted.
+    //
+    //        A value converts from a 'var' by 'value(x)', and back by 'to_var()'.
+    //
+    /********************************************************************************************/
+
+    class value {
+
+        using bits_type = std::uint64_t;
+
+        static constexpr bits_type nan_bits     = 0x7FF8'0000'0000'0000ull;  // Canonical quiet NaN.
+        static constexpr bits_type tag_mask     = 0xFFFF'0000'0000'0000ull;
+        static constexpr bits_type payload_mask = 0x0000'FFFF'FFFF'FFFFull;
+
+        static constexpr bits_type integer_tag  = 0xFFF9'0000'0000'0000ull;
+        static constexpr bits_type boolean_tag  = 0xFFFA'0000'0000'0000ull;
+        static constexpr bits_type op_code_tag  = 0xFFFB'0000'0000'0000ull;
+        static constexpr bits_type nothing_tag  = 0xFFFC'0000'0000'0000ull;
+        static constexpr bits_type pointer_tag  = 0xFFFD'0000'0000'0000ull;
+        static constexpr bits_type symbol_tag   = 0xFFFE'0000'0000'0000ull;
+
+        bits_type _bits;
+
+    public:
+
+        value()                           noexcept;
+        value(double x)                   noexcept;
+        value(std::int32_t x)             noexcept;
+        value(bool x)                     noexcept;
+        value(op_code x)                  noexcept;
+        value(const symbol& x)            noexcept;
+        explicit value(const var& x);
+        ~value()                          noexcept;
+
+        value(const value& other);
+        value(value&& other)              noexcept;
+        value& operator=(const value& other);
+        value& operator=(value&& other)   noexcept;
+
+        bool      is_real()         const noexcept;
+        bool   is_integer()         const noexcept;
+        bool   is_boolean()         const noexcept;
+        bool   is_op_code()         const noexcept;
+        bool    is_symbol()         const noexcept;
+        bool   is_nothing()         const noexcept;
+        bool     is_boxed()         const noexcept;  // Does the value hold a pointer to a 'var'?
+
+        double          as_real()    const noexcept;  // Reals and integers as a double.
+        std::int32_t as_integer()    const noexcept;
+        bool         as_boolean()    const noexcept;
+        op_code      as_op_code()    const noexcept;
+        symbol        as_symbol()    const noexcept;
+
+        var              to_var()    const;
+
+        friend bool operator==(const value& a, const value& b);
+
+    private:
+
+        bits_type tag()              const noexcept;
+        var*      boxed()            const noexcept;
+
+        static bits_type box(var* ptr) noexcept;
+    };
+
+    static_assert(sizeof(value) == 8, "A value must fit in 8 bytes.");
+
+    /********************************************************************************************/
+    //
+    //                                 'value' Class Implementation
+    //
+    /********************************************************************************************/
+
+    inline value::value() noexcept : _bits(nothing_tag) {
+    }
+
+    inline value::value(double x) noexcept : _bits(std::isnan(x) ? nan_bits : std::bit_cast<bits_type>(x)) {
+    }
+
+    inline value::value(std::int32_t x) noexcept : _bits(integer_tag | static_cast<std::uint32_t>(x)) {
+    }
+
+    inline value::value(bool x) noexcept : _bits(boolean_tag | static_cast<bits_type>(x)) {
+    }
+
+    inline value::value(op_code x) noexcept : _bits(op_code_tag | static_cast<bits_type>(x)) {
+    }
+
+    inline value::value(const symbol& x) noexcept : _bits(symbol_tag | static_cast<bits_type>(x.id())) {
+    }
+
+    inline value::value(const var& x) : _bits(nothing_tag) {
+
+        if (x.is_nothing()) {
+            return;
+        }
+
+        if (auto n = x.cast<number>()) {
+
+            if (auto i = std::get_if<number::int_type>(&n->_value)) {
+
+                if (*i >= std::numeric_limits<std::int32_t>::min() && *i <= std::numeric_limits<std::int32_t>::max()) {
+                    _bits = value(static_cast<std::int32_t>(*i))._bits;
+                    return;
+                }
+            }
+
+            else if (auto r = std::get_if<number::val_type>(&n->_value)) {
+                _bits = value(*r)._bits;
+                return;
+            }
+        }
+
+        else if (auto b = x.cast<boolean>()) {
+
+            if (b->_cert == 1.0 && (b->_term == 0.0 || b->_term == 1.0)) {
+                _bits = value(b->_term == 1.0)._bits;
+                return;
+            }
+        }
+
+        else if (x.is<op_call>()) {
+            _bits = value(x.op_call())._bits;
+            return;
+        }
+
+        else if (auto s = x.cast<symbol>()) {
+            _bits = value(*s)._bits;
+            return;
+        }
+
+        _bits = box(new var(x));
+    }
+
+    inline value::~value() noexcept {
+        delete boxed();
+    }
+
+    inline value::value(const value& other) : _bits(other._bits) {
+        if (auto p = other.boxed()) {
+            _bits = box(new var(*p));
+        }
+    }
+
+    inline value::value(value&& other) noexcept : _bits(std::exchange(other._bits, nothing_tag)) {
+    }
+
+    inline value& value::operator=(const value& other) {
+        if (this != &other) {
+            value temp(other);
+            *this = std::move(temp);
+        }
+        return *this;
+    }
+
+    inline value& value::operator=(value&& other) noexcept {
+        if (this != &other) {
+            delete boxed();
+            _bits = std::exchange(other._bits, nothing_tag);
+        }
+        return *this;
+    }
+
+    inline value::bits_type value::tag() const noexcept {
+        return _bits & tag_mask;
+    }
+
+    inline var* value::boxed() const noexcept {
+        return tag() == pointer_tag ? reinterpret_cast<var*>(static_cast<std::uintptr_t>(_bits & payload_mask)) : nullptr;
+    }
+
+    inline value::bits_type value::box(var* ptr) noexcept {
+
+        const auto bits = static_cast<bits_type>(reinterpret_cast<std::uintptr_t>(ptr));
+
+        if (bits & ~payload_mask) {
+            std::fputs("A var boxed by a value has an address wider than 48 bits.\n", stderr);
+            std::terminate();
+        }
+
+        return pointer_tag | bits;
+    }
+
+    inline bool value::is_real() const noexcept {
+        return _bits < integer_tag;
+    }
+
+    inline bool value::is_integer() const noexcept {
+        return tag() == integer_tag;
+    }
+
+    inline bool value::is_boolean() const noexcept {
+        return tag() == boolean_tag;
+    }
+
+    inline bool value::is_op_code() const noexcept {
+        return tag() == op_code_tag;
+    }
+
+    inline bool value::is_symbol() const noexcept {
+        return tag() == symbol_tag;
+    }
+
+    inline bool value::is_nothing() const noexcept {
+        return tag() == nothing_tag;
+    }
+
+    inline bool value::is_boxed() const noexcept {
+        return tag() == pointer_tag;
+    }
+
+    inline double value::as_real() const noexcept {
+        return is_integer() ? static_cast<double>(as_integer()) : std::bit_cast<double>(_bits);
+    }
+
+    inline std::int32_t value::as_integer() const noexcept {
+        return static_cast<std::int32_t>(static_cast<std::uint32_t>(_bits));
+    }
+
+    inline bool value::as_boolean() const noexcept {
+        return _bits & 1ull;
+    }
+
+    inline op_code value::as_op_code() const noexcept {
+        return static_cast<op_code>(_bits & payload_mask);
+    }
+
+    inline symbol value::as_symbol() const noexcept {
+
+        symbol s;
+        s._id = static_cast<symbol_table::id_type>(_bits & payload_mask);
+
+        return s;
+    }
+
+    inline var value::to_var() const {
+
+        switch (tag()) {
+
+        case integer_tag:
+            return number(static_cast<long long>(as_integer()));
+
+        case boolean_tag:
+            return boolean(as_boolean());
+
+        case op_code_tag:
+            return op_call(as_op_code());
+
+        case symbol_tag:
+            return as_symbol();
+
+        case nothing_tag:
+            return var();
+
+        case pointer_tag:
+            return *boxed();
+        }
+
+        return number(std::complex<double>(as_real(), 0.0));
+    }
+
+    inline bool operator==(const value& a, const value& b) {
+
+        if (a.is_boxed() || b.is_boxed()) {
+            return a.to_var() == b.to_var();
+        }
+
+        if ((a.is_real() || a.is_integer()) && (b.is_real() || b.is_integer())) {
+            return a.as_real() == b.as_real();
+        }
+
+        return a._bits == b._bits;
+    }
+}
@@ -24,14 +24,23 @@
 //
 /*****************************************************************************************/
 
+#include <array>
+#include <atomic>
 #include <compare>
+#include <cstddef>
+#include <functional>
+#include <limits>
 #include <memory>
+#include <new>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 #include "../../toolbox/text_support.h"
 #include "Error.h"
+#include "NodePool.h"
 #include "OpCodes.h"
+#include "TypeIds.h"
 
 namespace Oliver {
 
@@ -99,14 +108,49 @@ namespace Oliver {
 
     const enum class op_code;
 
+    class infix_table;
+
+    /*
+        A type may intern its most common values by specializing 'interned'.
+        Each interned value is constructed once, in static storage, and is
+        shared by every var holding it.  Copying such a var copies a pointer,
+        without allocating or touching a reference count.  The payload is
+        never destroyed, and is only copied when it is moved out of a var.
+
+        So the kernels of a type which interns its values must not modify
+        'self', as each is called on the interned payload directly.  Those
+        which are called without a detach, ('abs', 'lead', 'get' and the like),
+        take 'self' by const reference, so this is checked by the compiler.
+    */
+    template<typename T>
+    struct interned {
+        static constexpr std::size_t size = 0;                      // The number of interned values.
+
+        static std::size_t index(const T& x) noexcept;              // The index of 'x', or 'size' when not interned.
+        static T           value(std::size_t i);                    // The value interned at 'i'.
+    };
+
+    /*
+        A type whose copies are costly, such as a sequence, opts in to sharing
+        its payload between copies by specializing 'shared_payload'.  This has
+        effect only when built with OLIVER_COPY_ON_WRITE.
+    */
+    template<typename T>
+    struct shared_payload {
+        static constexpr bool value = false;
+    };
+
     class var {
         struct interface_type;
         template<typename T> struct data_type;
 
+        friend class infix_table;
+
     public:
 
         var();
-        template <typename T> var(T  x);
+        template <typename T> requires (!std::is_same_v<std::remove_cvref_t<T>, var> && !std::is_pointer_v<std::decay_t<T>>)
+                              var(T&& x);  // Forward the payload into place, so 'return std::move(self);' moves it once.
         template <typename T> var(T* x);
         virtual ~var() noexcept;
 
@@ -121,8 +165,19 @@ namespace Oliver {
         template<typename T> std::unique_ptr<T>       copy()  const;  // Get a unique pointer copy of the var data.
         template<typename T> std::unique_ptr<T>       move()       ;  // Transfer ownership of the pointer.
 
+        struct intern_statistics {
+            std::uint64_t hits;             // Payloads shared from an interned table.
+            std::uint64_t misses;           // Payloads of an interning type, whose value was not interned.
+        };
+
+        static intern_statistics intern_stats()              noexcept;  // The counts of the calling thread.
+
         constexpr std::string    str(const Format_Args& fmt)  const;  // String representation of the object, with FMT.
-        std::string             type()                        const;  // The class generated type name.
+        void                   write(fmt::memory_buffer& out,
+                                     const Format_Args& fmt)  const;  // Append the string representation to 'out'.
+        std::string             type()                        const;  // The class generated type name, for display.
+        type_id_t            type_id()                        const;  // The integer id of the wrapped type.
+        template<typename T> bool is()                        const;  // Is the wrapped type 'T'?
         op_code              op_call()                        const;  // Get the operator code from the operator class.
         std::size_t        size_type()                        const;  // Convert the object to a size_type.
         std::int64_t    integer_type()                        const;  // Convert the object to a 64 bit integer.
@@ -133,39 +188,55 @@ namespace Oliver {
         bool      is_something()                              const;
         bool       is_function()                              const;
 
-        bool       operator ==(var n)                         const;
-        order      operator<=>(var n)                         const;
+        bool       operator ==(const var& n)                  const;
+        order      operator<=>(const var& n)                  const;
 
-        var          operator&(var n)                              ;
-        var          operator|(var n)                              ;
-        var          operator^(var n)                              ;
+        var          operator&(const var& n)                       ;
+        var          operator|(const var& n)                       ;
+        var          operator^(const var& n)                       ;
         var          operator~()                                   ;
 
         var          operator+()                                   ;
         var          operator-()                                   ;
 
-        var          operator+(var n)                              ;
-        var          operator-(var n)                              ;
-        var          operator*(var n)                              ;
-        var          operator/(var n)                              ;
-        var          operator%(var n)                              ;
+        var          operator+(const var& n)                       ;
+        var          operator+(var&& n)                            ;  // A temporary operand may have its contents taken.
+        var          operator-(const var& n)                       ;
+        var          operator*(const var& n)                       ;
+        var          operator/(const var& n)                       ;
+        var          operator%(const var& n)                       ;
 
-        var                pow(var n)                              ;  // Raise to the power of.
-        var               root(var n)                              ;  // Reduce to the root of.
+        var              f_div(const var& n)                       ;  // Divide, rounding down to an integer.
+        var                rem(const var& n)                       ;  // The remainder of a truncated division.
+        var   elementwise(op_code op, const var& n)                ;  // Apply an infix operator to each pair of elements.
+
+        var                pow(const var& n)                       ;  // Raise to the power of.
+        var               root(const var& n)                       ;  // Reduce to the root of.
         var               real()                                   ;  // The real value of a number
         var               imag()                                   ;  // The imaginary value of a number.
         var                abs()                                   ;  // Absolute value of an object.
 
+        var                exp()                                   ;  // Raise e to the power of.
+        var                log()                                   ;  // The natural logarithm.
+        var                sin()                                   ;  // Trigonometric functions, in radians.
+        var                cos()                                   ;
+        var                tan()                                   ;
+        var               sinh()                                   ;  // Hyperbolic functions.
+        var               cosh()                                   ;
+        var               tanh()                                   ;
+
         var               lead()                                   ;  // Lead element of an object.
-        var               push(var n)                              ;  // Place an object as the lead element.
+        var               push(const var& n)                       ;  // Place an object as the lead element.
+        var               push(var&& n)                            ;
         var               drop()                                   ;  // Remove the lead element from an object.
         var              shift()                                   ;  // Get and drop the lead element of a sequence.  
         var            reverse()                                   ;  // Reverse the order of an object's elements.
 
-        var         get(var index)                                 ;  // Get the value of an index.
-        var         set(var index, var value)                      ;  // Set the value of an index.
-        var         del(var index)                                 ;  // Delete the value of an index.
-        var         has(var index)                                 ;  // Determine if index is a member of the object.
+        var         get(const var& index)                          ;  // Get the value of an index.
+        var         set(const var& index, const var& value)        ;  // Set the value of an index.
+        var         set(const var& index, var&& value)             ;
+        var         del(const var& index)                          ;  // Delete the value of an index.
+        var         has(const var& index)                          ;  // Determine if index is a member of the object.
 
         //      union -> The common elements of two sets.  Logical Or
         //      inrtersection -> All elements exclusive to both sets.  Logical And
@@ -186,55 +257,80 @@ namespace Oliver {
             //                              'interface_type' Class Definition
             //
             //       A simple interface description allowing redirection of the 'var' data type.
+            //       The type id of the wrapped data is held as a tag, so that a checked
+            //       downcast is a single integer comparison rather than a dynamic_cast.
             //
             /********************************************************************************************/
 
+            interface_type(type_id_t tag) : _tag(tag), _refs(1) {};
             virtual ~interface_type() {};
 
-            virtual std::unique_ptr<interface_type> clone()         const = 0;
+            const type_id_t _tag;
+
+            mutable std::atomic<std::uint32_t> _refs;  // Number of vars sharing a heap payload.
+
+            virtual interface_type* clone_to(void* local)           const = 0;  // Copy the payload, into 'local' if it fits.
+            virtual interface_type* move_to(void* local)         noexcept = 0;  // Move a local payload into 'local'.
 
             virtual operator bool()                                 const = 0;
 
             virtual std::string     _type()                         const = 0;
             virtual bool            _is()                           const = 0;
             virtual std::string     _str(const Format_Args& fmt)    const = 0;
+            virtual void          _write(fmt::memory_buffer& out,
+                                         const Format_Args& fmt)    const = 0;
             virtual std::size_t     _size_type()                    const = 0;
             virtual std::int64_t    _integer_type()                 const = 0;
 
             virtual bool            _is_nothing()                   const = 0;
             virtual bool            _is_function()                  const = 0;
 
-            virtual order           _comp(var n)                    const = 0;
+            virtual order           _comp(const var& n)             const = 0;
 
-            virtual var             _and(var n)                           = 0;
-            virtual var             _or(var n)                            = 0;
-            virtual var             _xor(var n)                           = 0;
+            virtual var             _and(const var& n)                    = 0;
+            virtual var             _or(const var& n)                     = 0;
+            virtual var             _xor(const var& n)                    = 0;
             virtual var             _neg()                                = 0;
 
             virtual var             _u_add()                              = 0;
 
-            virtual var             _add(var n)                           = 0;
-            virtual var             _sub(var n)                           = 0;
-            virtual var             _mul(var n)                           = 0;
-            virtual var             _div(var n)                           = 0;
-            virtual var             _mod(var n)                           = 0;
-
-            virtual var             _pow(var n)                           = 0;
-            virtual var             _root(var n)                          = 0;
-            virtual var             _real()                               = 0;
-            virtual var             _imag()                               = 0;
-            virtual var             _abs()                                = 0;
-
-            virtual var             _lead()                               = 0;
-            virtual var             _push(var n)                          = 0;
+            virtual var             _add(const var& n)                    = 0;
+            virtual var             _add(var&& n)                         = 0;
+            virtual var             _sub(const var& n)                    = 0;
+            virtual var             _mul(const var& n)                    = 0;
+            virtual var             _div(const var& n)                    = 0;
+            virtual var             _mod(const var& n)                    = 0;
+            virtual var             _f_div(const var& n)                  = 0;
+            virtual var             _rem(const var& n)                    = 0;
+            virtual var             _elementwise(op_code op, const var& n) = 0;
+
+            virtual var             _pow(const var& n)                    = 0;
+            virtual var             _root(const var& n)             const = 0;
+            virtual var             _real()                         const = 0;
+            virtual var             _imag()                         const = 0;
+            virtual var             _abs()                          const = 0;
+
+            virtual var             _exp()                          const = 0;
+            virtual var             _log()                          const = 0;
+            virtual var             _sin()                          const = 0;
+            virtual var             _cos()                          const = 0;
+            virtual var             _tan()                          const = 0;
+            virtual var             _sinh()                         const = 0;
+            virtual var             _cosh()                         const = 0;
+            virtual var             _tanh()                         const = 0;
+
+            virtual var             _lead()                         const = 0;
+            virtual var             _push(const var& n)                   = 0;
+            virtual var             _push(var&& n)                        = 0;
             virtual var             _drop()                               = 0;
             virtual var             _shift()                              = 0;
             virtual var             _reverse()                            = 0;
 
-            virtual var             _get(var n)                           = 0;
-            virtual var             _set(const var& i, var n)             = 0;
-            virtual var             _del(var n)                           = 0;
-            virtual var             _has(var n)                           = 0;
+            virtual var             _get(const var& n)              const = 0;
+            virtual var             _set(const var& i, const var& n)      = 0;
+            virtual var             _set(const var& i, var&& n)           = 0;
+            virtual var             _del(const var& n)                    = 0;
+            virtual var             _has(const var& n)              const = 0;
 
             virtual op_code         _op_call()                      const = 0;
         };
@@ -251,7 +347,8 @@ namespace Oliver {
             //
             /******************************************************************************************/
 
-            data_type(T val);
+            template <typename U>
+            explicit data_type(U&& val);
             virtual ~data_type();
 
             operator bool()                                 const;
@@ -261,41 +358,58 @@ namespace Oliver {
 
             bool            _is()                           const;
             std::string     _str(const Format_Args& fmt)    const;
+            void          _write(fmt::memory_buffer& out,
+                                 const Format_Args& fmt)    const;
 
             bool            _is_nothing()                   const;
             bool            _is_function()                  const;
 
-            order           _comp(var n)                    const;
+            order           _comp(const var& n)             const;
 
-            var             _and(var n)                          ;
-            var             _or(var n)                           ;
-            var             _xor(var n)                          ;
+            var             _and(const var& n)                   ;
+            var             _or(const var& n)                    ;
+            var             _xor(const var& n)                   ;
             var             _neg()                               ;
 
             var             _u_add()                             ;
 
-            var             _add(var n)                          ;
-            var             _sub(var n)                          ;
-            var             _mul(var n)                          ;
-            var             _div(var n)                          ;
-            var             _mod(var n)                          ;
-
-            var             _pow(var n)                          ;
-            var             _root(var n)                         ;
-            var             _real()                              ;
-            var             _imag()                              ;
-            var             _abs()                               ;
-
-            var             _lead()                              ;
-            var             _push(var n)                         ;
+            var             _add(const var& n)                   ;
+            var             _add(var&& n)                        ;
+            var             _sub(const var& n)                   ;
+            var             _mul(const var& n)                   ;
+            var             _div(const var& n)                   ;
+            var             _mod(const var& n)                   ;
+            var             _f_div(const var& n)                 ;
+            var             _rem(const var& n)                   ;
+            var             _elementwise(op_code op, const var& n);
+
+            var             _pow(const var& n)                   ;
+            var             _root(const var& n)             const;
+            var             _real()                         const;
+            var             _imag()                         const;
+            var             _abs()                          const;
+
+            var             _exp()                          const;
+            var             _log()                          const;
+            var             _sin()                          const;
+            var             _cos()                          const;
+            var             _tan()                          const;
+            var             _sinh()                         const;
+            var             _cosh()                         const;
+            var             _tanh()                         const;
+
+            var             _lead()                         const;
+            var             _push(const var& n)                  ;
+            var             _push(var&& n)                       ;
             var             _drop()                              ;
             var             _shift()                             ;
             var             _reverse()                           ;
 
-            var             _get(var n)                         ;
-            var             _set(const var& i, var n)           ;
-            var             _del(var n)                         ;
-            var             _has(var n)                         ;
+            var             _get(const var& n)              const;
+            var             _set(const var& i, const var& n)    ;
+            var             _set(const var& i, var&& n)         ;
+            var             _del(const var& n)                  ;
+            var             _has(const var& n)              const;
 
             op_code         _op_call()                      const;
 
@@ -316,14 +430,71 @@ namespace Oliver {
 
             T _data;
 
-            std::unique_ptr<interface_type> clone() const;
+            interface_type* clone_to(void* local)           const;
+            interface_type* move_to(void* local)         noexcept;
+
+            // Heap allocated nodes are served from the 'node_pool'.
+            static void* operator new(std::size_t size);
+            static void  operator delete(void* ptr, std::size_t size) noexcept;
         };
 
-        std::unique_ptr<interface_type> _self;
+        /*
+            Small payloads which can be moved without throwing are constructed
+            in place within the '_local' buffer, rather than on the heap.  This
+            covers the scalar types, (number, boolean, op_call, nothing) as well
+            as list and expression.  Anything larger, (such as text, whose string
+            carries its memory resource), falls back to a pooled heap allocation.
+        */
+        static constexpr std::size_t local_size  = 48;
+        static constexpr std::size_t local_align = alignof(std::max_align_t);
+
+        /*
+            When built with OLIVER_COPY_ON_WRITE, copies of a var share its heap
+            payload, and only make their own copy once a mutating method is called.
+            The payloads of a 'shared_payload' type are then kept on the heap, so
+            that text, lists, expressions and objects copy in constant time.  The
+            scalars stay in place either way.
+        */
+#ifdef OLIVER_COPY_ON_WRITE
+        static constexpr bool copy_on_write = true;
+#else
+        static constexpr bool copy_on_write = false;
+#endif
+
+        template<typename T>
+        static constexpr bool is_local = sizeof(data_type<T>) <= local_size && alignof(data_type<T>) <= local_align
+                                        && std::is_nothrow_move_constructible_v<T>
+                                        && !(copy_on_write && shared_payload<T>::value);
+
+        /*
+            An interned payload is marked by its reference count, which is never
+            changed.  The counts are kept per thread, so a hit costs no more than
+            the pointer copy it replaces.
+        */
+        static constexpr std::uint32_t immortal = std::numeric_limits<std::uint32_t>::max();
+
+        static inline thread_local std::uint64_t _intern_hits   = 0;
+        static inline thread_local std::uint64_t _intern_misses = 0;
+
+        template<typename T> static interface_type* const* interned_table();
+
+        interface_type* _self = nullptr;
+
+        alignas(local_align) std::byte _local[local_size];
+
+        template<typename T> void emplace(T&& x);  // Construct a new payload, locally if it fits.
+        bool             is_local_self() const noexcept;
+        bool          is_immortal_self() const noexcept;
+        void                     reset()       noexcept;  // Destroy the current payload.
+        void                take(var& other)   noexcept;  // Take the payload of 'other', which is left empty.
+        void                    detach()               ;  // Ensure a heap payload is not shared, before mutating it.
 
         constexpr void check_is_initialized();
     };
 
+    static_assert(std::is_nothrow_move_constructible_v<var> && std::is_nothrow_move_assignable_v<var>,
+                  "Moving a var must neither throw nor allocate.");
+
     /********************************************************************************************/
     //
     //                                 'nothing' Class Definition
@@ -345,12 +516,87 @@ namespace Oliver {
 
         friend std::string          _type_(const nothing& self);
         friend bool                   _is_(const nothing& self);
-        friend order                _comp_(const nothing& self, var n);
+        friend order                _comp_(const nothing& self, const var& n);
         friend std::string           _str_(const nothing& self, const Format_Args& fmt);
 
         friend bool           _is_nothing_(const nothing& self);
     };
 
+    template<>
+    struct interned<nothing> {
+        static constexpr std::size_t size = 1;
+
+        static std::size_t index(const nothing&) noexcept { return 0; }
+        static nothing     value(std::size_t)             { return nothing(); }
+    };
+
+    /********************************************************************************************/
+    //
+    //                                'infix_table' Class Definition
+    //
+    //          The infix table maps an infix operator, and the type ids of its left and
+    //          right operands, directly to a function implementing the operation.  The
+    //          'var' operators consult the table first, and only fall back to the
+    //          virtual '_add', '_sub', ... of the left operand when no entry exists.
+    //
+    //          An entry calls a typed kernel, '_add_(const L& self, const R& other)' etc.
+    //          A kernel only reads its operands, so the operators do not detach 'self'
+    //          from a shared payload before calling an entry.
+    //          Operands of differing types are first promoted to a common type using
+    //          '_promote_', making every mixed type rule explicit.  Pairs which are not
+    //          defined are left to the virtual path.  As are list and expression
+    //          concatenation, which need the rvalue overloads to splice a temporary.
+    //
+    //          The comparison operators share one entry per pair of types, which calls
+    //          '_comp_(const C& self, const C& other)' for the ordering of both.
+    //
+    //          Only registered types have an entry.  The built in entries are defined
+    //          by 'define_infix_rules', in 'data_types.h', on the first lookup.  So an
+    //          operation run during the static initialization of any translation unit
+    //          still finds them.
+    //
+    /********************************************************************************************/
+
+    using infix_function   = var(*)(const var& self, const var& other);
+    using compare_function = order(*)(const var& self, const var& other);
+
+    inline void define_infix_rules();  // Defined in 'data_types.h', where every rule's types are complete.
+
+    class infix_table {
+
+    public:
+
+        static infix_function   find(op_code op, type_id_t left, type_id_t right) noexcept;
+        static compare_function find_comparison(type_id_t left, type_id_t right)  noexcept;
+
+        template<op_code Op, typename L, typename R, typename C = L>
+        static void define();  // Define 'L Op R', evaluated on 'L' and 'R' promoted to 'C'.
+
+        template<typename L, typename R, typename C = L>
+        static void define_comparison();  // Define the ordering of 'L' and 'R', compared as 'C'.
+
+    private:
+
+        static constexpr std::size_t op_count   = static_cast<std::size_t>(op_code::INFIX_OPERATORS_STOP)
+                                                - static_cast<std::size_t>(op_code::INFIX_OPERATORS_START) - 1;
+        static constexpr std::size_t type_count = registered_types::size;
+
+        static inline constinit std::array<infix_function, op_count * type_count * type_count> _functions{};
+        static inline constinit std::array<compare_function, type_count * type_count>          _comparisons{};
+
+        static void                  rules_defined() noexcept;  // Define the built in rules, once.
+        static constexpr std::size_t index(op_code op, type_id_t left, type_id_t right) noexcept;
+
+        template<op_code Op, typename C>
+        static var kernel(const C& self, const C& other);
+
+        template<op_code Op, typename L, typename R, typename C>
+        static var apply(const var& self, const var& other);
+
+        template<typename L, typename R, typename C>
+        static order compare(const var& self, const var& other);
+    };
+
     /********************************************************************************************/
     //
     //                      'var' Class Function Default Template API.
@@ -362,9 +608,21 @@ namespace Oliver {
     //           Each function defined here defines the default behavior of each function
     //           which is invoked if a function is not overwritten for a defined class.
     //
+    //           Operands are passed by const reference.  '_add_', '_push_' and '_set_'
+    //           may also be overloaded on 'var&&', allowing a class to take the contents
+    //           of a temporary operand rather than copying it.
+    //
+    //           '_lead_', '_get_', '_has_', '_abs_', '_real_', '_imag_' and '_root_' must
+    //           not modify 'self', or move from it.  They are called on a payload which
+    //           may be shared with other vars, so a read does not copy it first.
+    //
     /********************************************************************************************/
 
 
+    template<typename To, typename From>  /****  Promote To A Common Type  ****/
+    To _promote_(const From& self);     // Defined for each mixed type rule of the 'infix_table'.
+
+
     template<typename T>            /****  Type Name  ****/
     std::string _type_(const T& self);
 
@@ -419,11 +677,21 @@ namespace Oliver {
     }
 
 
+    template<typename T>            /****  String Conversion Into A Buffer  ****/
+    void _write_(const T& self, fmt::memory_buffer& out, const Format_Args& fmt);
+
+    template<typename T>
+    inline void _write_(const T& self, fmt::memory_buffer& out, const Format_Args& fmt) {
+        const std::string str = _str_(self, fmt);
+        out.append(str.data(), str.data() + str.size());
+    }
+
+
     template<typename T>            /****  Comparison Between Variables  ****/
-    order _comp_(const T& self, var n);
+    order _comp_(const T& self, const var& n);
 
     template<typename T>
-    inline order _comp_(const T& self, var n) {
+    inline order _comp_(const T& self, const var& n) {
         return order::unordered;
     }
 
@@ -447,28 +715,28 @@ namespace Oliver {
 
 
     template<typename T>            /****  Logical Conjunction  ****/
-    var _and_(T& self, var n);
+    var _and_(T& self, const var& n);
 
     template<typename T>
-    inline var _and_(T& self, var n) {
+    inline var _and_(T& self, const var& n) {
         return var();
     }
 
 
     template<typename T>            /****  Logical Inclusive Disjunction  ****/
-    var _or_(T& self, var n);
+    var _or_(T& self, const var& n);
 
     template<typename T>
-    inline var _or_(T& self, var n) {
+    inline var _or_(T& self, const var& n) {
         return var();
     }
 
 
     template<typename T>            /****  Logical Exclusive Disjunction  ****/
-    var _xor_(T& self, var n);
+    var _xor_(T& self, const var& n);
 
     template<typename T>
-    inline var _xor_(T& self, var n) {
+    inline var _xor_(T& self, const var& n) {
         return var();
     }
 
@@ -492,110 +760,209 @@ namespace Oliver {
 
 
     template<typename T>            /****  Addition or Concatenation  ****/
-    var _add_(T& self, var n);
+    var _add_(T& self, const var& n);
 
     template<typename T>
-    inline var _add_(T& self, var n) {
+    inline var _add_(T& self, const var& n) {
         return var();
     }
 
 
     template<typename T>            /****  Subtraction ****/
-    var _sub_(T& self, var n);
+    var _sub_(T& self, const var& n);
 
     template<typename T>
-    inline var _sub_(T& self, var n) {
+    inline var _sub_(T& self, const var& n) {
         return var();
     }
 
 
     template<typename T>            /****  Multiplication ****/
-    var _mul_(T& self, var n);
+    var _mul_(T& self, const var& n);
 
     template<typename T>
-    inline var _mul_(T& self, var n) {
+    inline var _mul_(T& self, const var& n) {
         return var();
     }
 
 
     template<typename T>            /****  Division  ****/
-    var _div_(T& self, var n);
+    var _div_(T& self, const var& n);
 
     template<typename T>
-    inline var _div_(T& self, var n) {
+    inline var _div_(T& self, const var& n) {
         return var();
     }
 
 
     template<typename T>            /****  Modulation  ****/
-    var _mod_(T& self, var n);
+    var _mod_(T& self, const var& n);
+
+    template<typename T>
+    inline var _mod_(T& self, const var& n) {
+        return var();
+    }
+
+
+    template<typename T>            /****  Floor Division  ****/
+    var _f_div_(T& self, const var& n);
+
+    template<typename T>
+    inline var _f_div_(T& self, const var& n) {
+        return var();
+    }
+
+
+    template<typename T>            /****  Remainder  ****/
+    var _rem_(T& self, const var& n);
+
+    template<typename T>
+    inline var _rem_(T& self, const var& n) {
+        return var();
+    }
+
+
+    template<typename T>            /****  Element-wise Operation  ****/
+    var _elementwise_(T& self, op_code op, const var& n);
 
     template<typename T>
-    inline var _mod_(T& self, var n) {
+    inline var _elementwise_(T& self, op_code op, const var& n) {
         return var();
     }
 
 
     template<typename T>            /****  To Power Of  ****/
-    var _pow_(T& self, var n);
+    var _pow_(T& self, const var& n);
 
     template<typename T>
-    inline var _pow_(T& self, var n) {
+    inline var _pow_(T& self, const var& n) {
         return var();
     }
 
 
     template<typename T>            /****  To Root Of  ****/
-    var _root_(T& self, var n);
+    var _root_(const T& self, const var& n);
 
     template<typename T>
-    inline var _root_(T& self, var n) {
+    inline var _root_(const T& self, const var& n) {
         return var();
     }
 
 
     template<typename T>            /****  Real Value  ****/
-    var _real_(T& self);
+    var _real_(const T& self);
 
     template<typename T>
-    inline var _real_(T& self) {
+    inline var _real_(const T& self) {
         return var();
     }
 
 
     template<typename T>            /****  Imaginary Value  ****/
-    var _imag_(T& self);
+    var _imag_(const T& self);
 
     template<typename T>
-    inline var _imag_(T& self) {
+    inline var _imag_(const T& self) {
         return var();
     }
 
 
     template<typename T>            /****  Absolute Value  ****/
-    var _abs_(T& self);
+    var _abs_(const T& self);
+
+    template<typename T>
+    inline var _abs_(const T& self) {
+        return var();
+    }
+
+
+    template<typename T>            /****  Exponential  ****/
+    var _exp_(const T& self);
+
+    template<typename T>
+    inline var _exp_(const T& self) {
+        return var();
+    }
+
+
+    template<typename T>            /****  Natural Logarithm  ****/
+    var _log_(const T& self);
 
     template<typename T>
-    inline var _abs_(T& self) {
+    inline var _log_(const T& self) {
+        return var();
+    }
+
+
+    template<typename T>            /****  Sine  ****/
+    var _sin_(const T& self);
+
+    template<typename T>
+    inline var _sin_(const T& self) {
+        return var();
+    }
+
+
+    template<typename T>            /****  Cosine  ****/
+    var _cos_(const T& self);
+
+    template<typename T>
+    inline var _cos_(const T& self) {
+        return var();
+    }
+
+
+    template<typename T>            /****  Tangent  ****/
+    var _tan_(const T& self);
+
+    template<typename T>
+    inline var _tan_(const T& self) {
+        return var();
+    }
+
+
+    template<typename T>            /****  Hyperbolic Sine  ****/
+    var _sinh_(const T& self);
+
+    template<typename T>
+    inline var _sinh_(const T& self) {
+        return var();
+    }
+
+
+    template<typename T>            /****  Hyperbolic Cosine  ****/
+    var _cosh_(const T& self);
+
+    template<typename T>
+    inline var _cosh_(const T& self) {
+        return var();
+    }
+
+
+    template<typename T>            /****  Hyperbolic Tangent  ****/
+    var _tanh_(const T& self);
+
+    template<typename T>
+    inline var _tanh_(const T& self) {
         return var();
     }
 
 
     template<typename T>            /****  Lead Element Of  ****/
-    var _lead_(T& self);
+    var _lead_(const T& self);
 
     template<typename T>
-    inline var _lead_(T& self) {
+    inline var _lead_(const T& self) {
         auto fa = Format_Args{};
         return var(error("Invalid operation on type: " + _type_(self) + "value: " + _str_(self, fa)));
     }
 
 
     template<typename T>            /**** Prepend Lead Element Of  ****/
-    var _push_(T& self, var n);
+    var _push_(T& self, const var& n);
 
     template<typename T>
-    inline var _push_(T& self, var n) {
+    inline var _push_(T& self, const var& n) {
         return var();
     }
 
@@ -628,37 +995,37 @@ namespace Oliver {
 
 
     template<typename T>            /****  Get Object Index  ****/
-    var _get_(T& self, var n);
+    var _get_(const T& self, const var& n);
 
     template<typename T>
-    inline var _get_(T& self, var n) {
+    inline var _get_(const T& self, const var& n) {
         return var();
     }
 
 
     template<typename T>            /****  Set Object Index  ****/
-    var _set_(T& self, var& i, var n);
+    var _set_(T& self, const var& i, const var& n);
 
     template<typename T>
-    inline var _set_(T& self, const var& i, var n) {
+    inline var _set_(T& self, const var& i, const var& n) {
         return var();
     }
 
 
     template<typename T>            /****  Delete Object Index  ****/
-    var _del_(T& self, var n);
+    var _del_(T& self, const var& n);
 
     template<typename T>
-    inline var _del_(T& self, var n) {
+    inline var _del_(T& self, const var& n) {
         return var();
     }
 
 
     template<typename T>            /****  Does Object Have Index  ****/
-    var _has_(T& self, var n);
+    var _has_(const T& self, const var& n);
 
     template<typename T>
-    inline var _has_(T& self, var n) {
+    inline var _has_(const T& self, const var& n) {
         return var();
     }
 
@@ -676,7 +1043,7 @@ namespace Oliver {
         return false;
     }
 
-    inline order _comp_(const nothing& self, var n) {
+    inline order _comp_(const nothing& self, const var& n) {
         return order::unordered;
     }
 
@@ -694,81 +1061,204 @@ namespace Oliver {
     //
     /********************************************************************************************/
 
-    inline var::var() : _self(std::make_unique<data_type<nothing>>(nothing())) {
+    inline var::var() {
+        emplace(nothing());
     }
 
     inline var::~var() noexcept {
+        reset();
     }
 
-    template <typename T>
-    inline var::var(T x) : _self(std::make_unique<data_type<T>>(std::move(x))) {
-        if (type() == "std::nullptr_t") {
-            _self = std::make_unique<data_type<nothing>>(nothing());
+    template <typename T> requires (!std::is_same_v<std::remove_cvref_t<T>, var> && !std::is_pointer_v<std::decay_t<T>>)
+    inline var::var(T&& x) {
+        if constexpr (std::is_same_v<std::remove_cvref_t<T>, std::nullptr_t>) {
+            emplace(nothing());
+        }
+        else {
+            emplace(std::forward<T>(x));
         }
     }
 
     template <typename T>
-    inline var::var(T* x) : _self(std::make_unique<data_type<T>>(*x)) {
-        if (type() == "std::nullptr_t") {
-            _self = std::make_unique<data_type<nothing>>(nothing());
+    inline var::var(T* x) {
+        if (x) {
+            emplace(*x);
+        }
+        else {
+            emplace(nothing());
         }
     }
 
-    inline var::var(const var& other) : _self(other.is_something() ? other._self->clone() : std::make_unique<data_type<nothing>>(nothing())) {
+    inline var::var(const var& other) {
+        if (other.is_immortal_self()) {
+            _self = other._self;
+        }
+        else if (copy_on_write && other._self && !other.is_local_self()) {
+            other._self->_refs.fetch_add(1, std::memory_order_relaxed);
+            _self = other._self;
+        }
+        else if (other.is_something()) {
+            _self = other._self->clone_to(_local);
+        }
+        else {
+            emplace(nothing());
+        }
     }
 
-    inline var::var(var&& other) noexcept : _self(std::move(other._self)) {
-        other._self = std::make_unique<data_type<nothing>>(nothing());  // TODO:  Double check if this is needed.  I don't think so by C++ guidlines indicated it was.  
+    inline var::var(var&& other) noexcept {
+        take(other);
+        other.emplace(nothing());  // Moved from vars hold nothing, constructed in place so no allocation is made.
     }
 
     inline var& var::operator=(const var& other) {
         if (this != &other) {
-            _self = other._self->clone();
+            var temp(other);
+            *this = std::move(temp);
         }
         return *this;
     }
 
+    /*
+        The payload of 'other' is taken before the current one is destroyed, as
+        'other' may be owned by it.
+    */
     inline var& var::operator=(var&& other) noexcept {
         if (this != &other) {
-            _self = std::move(other._self);
-            other._self = std::make_unique<data_type<nothing>>(nothing());  // TODO:  Double check if this is needed.  I don't think so by C++ guidlines indicated it was.  
+            var temp(std::move(other));
+            reset();
+            take(temp);
         }
         return *this;
     }
 
+    template<typename T>
+    inline void var::emplace(T&& x) {
+        using U = std::remove_cvref_t<T>;
+
+        if constexpr (interned<U>::size > 0) {
+
+            if (const std::size_t i = interned<U>::index(x); i < interned<U>::size) {
+                _self = interned_table<U>()[i];
+                ++_intern_hits;
+                return;
+            }
+            ++_intern_misses;
+        }
+
+        if constexpr (is_local<U>) {
+            _self = ::new (static_cast<void*>(_local)) data_type<U>(std::forward<T>(x));
+        }
+        else {
+            _self = new data_type<U>(std::forward<T>(x));
+        }
+    }
+
+    inline void var::take(var& other) noexcept {
+        if (other.is_local_self()) {
+            _self = other._self->move_to(_local);
+            other.reset();
+        }
+        else {
+            _self = std::exchange(other._self, nullptr);
+        }
+    }
+
+    inline bool var::is_local_self() const noexcept {
+        const auto p = reinterpret_cast<const std::byte*>(_self);
+        return _self && !std::less<const std::byte*>{}(p, _local) && std::less<const std::byte*>{}(p, _local + local_size);
+    }
+
+    inline bool var::is_immortal_self() const noexcept {
+        return _self && _self->_refs.load(std::memory_order_relaxed) == immortal;
+    }
+
+    /*
+        The table is built on first use, and is deliberately never destroyed,
+        so that its payloads outlive any var in static storage.
+    */
+    template<typename T>
+    inline var::interface_type* const* var::interned_table() {
+
+        static const auto table = [] {
+
+            alignas(data_type<T>) static std::byte storage[interned<T>::size][sizeof(data_type<T>)];
+
+            std::array<interface_type*, interned<T>::size> nodes{};
+
+            for (std::size_t i = 0; i < interned<T>::size; ++i) {
+                nodes[i] = ::new (static_cast<void*>(storage[i])) data_type<T>(interned<T>::value(i));
+                nodes[i]->_refs.store(immortal, std::memory_order_relaxed);
+            }
+            return nodes;
+        }();
+
+        return table.data();
+    }
+
+    inline var::intern_statistics var::intern_stats() noexcept {
+        return { _intern_hits, _intern_misses };
+    }
+
+    inline void var::reset() noexcept {
+        if (is_local_self()) {
+            _self->~interface_type();
+        }
+        else if (is_immortal_self()) {
+            // Interned payloads are never destroyed.
+        }
+        else if (!copy_on_write || (_self && _self->_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)) {
+            delete _self;
+        }
+        _self = nullptr;
+    }
+
+    /*
+        An interned payload is left in place, its kernels do not modify it.
+    */
+    inline void var::detach() {
+        check_is_initialized();
+
+        if constexpr (copy_on_write) {
+
+            if (!is_local_self() && !is_immortal_self() && _self->_refs.load(std::memory_order_acquire) > 1) {
+                interface_type* p = _self->clone_to(_local);
+                reset();
+                _self = p;
+            }
+        }
+    }
+
     template<typename T>
     inline std::unique_ptr<T> var::move() {
-        if (_self) {
-            data_type<T>* p = dynamic_cast<typename std::unique_ptr<data_type<T>>::element_type*>(_self.release());
+        if (_self && _self->_tag == type_id_of<T>()) {
 
-            if (p) {
-                auto result = std::make_unique<T>(p->_data);
-                check_is_initialized();
-                return result;
+            if (is_immortal_self()) {
+                _self = _self->clone_to(_local);
             }
+            detach();
+
+            auto p = static_cast<data_type<T>*>(_self);
+
+            auto result = std::make_unique<T>(std::move(p->_data));
+            reset();
+            emplace(nothing());
+            return result;
         }
         return nullptr;
     }
 
     template <typename T>
     inline const T* var::cast() const {
-        if (_self) {
-            const auto p = dynamic_cast<data_type<T>*>(_self.get());
-
-            if (p) {
-                return std::addressof(p->_data);
-            }
+        if (_self && _self->_tag == type_id_of<T>()) {
+            return std::addressof(static_cast<const data_type<T>*>(_self)->_data);
         }
         return nullptr;
     }
 
     template <typename T>
     inline std::unique_ptr<T> var::copy() const {
-
-        const data_type<T>* p = dynamic_cast<typename std::unique_ptr<data_type<T>>::element_type*>(_self.get());
-
-        if (p) {
-            return std::make_unique<T>(p->_data);
+        if (_self && _self->_tag == type_id_of<T>()) {
+            return std::make_unique<T>(static_cast<const data_type<T>*>(_self)->_data);
         }
         return nullptr;
     }
@@ -777,6 +1267,15 @@ namespace Oliver {
         return _self ? _self->_type() : "nothing"s;
     }
 
+    inline type_id_t var::type_id() const {
+        return _self ? _self->_tag : type_id_of<nothing>();
+    }
+
+    template<typename T>
+    inline bool var::is() const {
+        return type_id() == type_id_of<T>();
+    }
+
     inline op_code var::op_call() const {
         return _self ? _self->_op_call() : op_code::nothing_op;
     }
@@ -793,6 +1292,16 @@ namespace Oliver {
         return _self != nullptr ? _self->_str(fmt) : "nothing"s;
     }
 
+    inline void var::write(fmt::memory_buffer& out, const Format_Args& fmt) const {
+        if (_self) {
+            _self->_write(out, fmt);
+        }
+        else {
+            constexpr std::string_view str = "nothing";
+            out.append(str.data(), str.data() + str.size());
+        }
+    }
+
     inline var::operator bool() const {
         return _self ? _self->_is() : false;
     }
@@ -809,137 +1318,275 @@ namespace Oliver {
         return _self ? _self->_is_function() : false;
     }
 
-    inline bool var::operator==(var n) const {
-        return _self ? _self->_comp(n) == order::equivalent: false;
+    inline bool var::operator==(const var& n) const {
+        return *this <=> n == order::equivalent;
     }
 
-    inline order var::operator<=>(var n) const {
-        return _self ? _self->_comp(n) : order::unordered;
+    inline order var::operator<=>(const var& n) const {
+
+        if (!_self) {
+            return order::unordered;
+        }
+
+        if (auto f = infix_table::find_comparison(_self->_tag, n.type_id())) {
+            return f(*this, n);
+        }
+        return _self->_comp(n);
     }
 
-    inline var var::operator&(var n) {
+    inline var var::operator&(const var& n) {
         check_is_initialized();
+
+        if (auto f = infix_table::find(op_code::AND_op, _self->_tag, n.type_id())) {
+            return f(*this, n);
+        }
+        detach();
         return _self->_and(n);
     }
 
-    inline var var::operator|(var n) {
+    inline var var::operator|(const var& n) {
         check_is_initialized();
+
+        if (auto f = infix_table::find(op_code::OR_op, _self->_tag, n.type_id())) {
+            return f(*this, n);
+        }
+        detach();
         return _self->_or(n);
     }
 
-    inline var var::operator^(var n) {
+    inline var var::operator^(const var& n) {
         check_is_initialized();
+
+        if (auto f = infix_table::find(op_code::XOR_op, _self->_tag, n.type_id())) {
+            return f(*this, n);
+        }
+        detach();
         return _self->_xor(n);
     }
 
     inline var var::operator+() {
-        check_is_initialized();
+        detach();
         return _self->_u_add();
     }
 
     inline var var::operator-() {
-        check_is_initialized();
+        detach();
         return _self->_neg();
     }
 
-    inline var var::operator+(var n) {
+    inline var var::operator+(const var& n) {
         check_is_initialized();
+
+        if (auto f = infix_table::find(op_code::ADD_op, _self->_tag, n.type_id())) {
+            return f(*this, n);
+        }
+        detach();
         return _self->_add(n);
     }
 
-    inline var var::operator-(var n) {
+    inline var var::operator+(var&& n) {
+        check_is_initialized();
+
+        if (auto f = infix_table::find(op_code::ADD_op, _self->_tag, n.type_id())) {
+            return f(*this, n);
+        }
+        detach();
+        return _self->_add(std::move(n));
+    }
+
+    inline var var::operator-(const var& n) {
         check_is_initialized();
+
+        if (auto f = infix_table::find(op_code::SUB_op, _self->_tag, n.type_id())) {
+            return f(*this, n);
+        }
+        detach();
         return _self->_sub(n);
     }
 
-    inline var var::operator*(var n) {
+    inline var var::operator*(const var& n) {
         check_is_initialized();
+
+        if (auto f = infix_table::find(op_code::MUL_op, _self->_tag, n.type_id())) {
+            return f(*this, n);
+        }
+        detach();
         return _self->_mul(n);
     }
 
-    inline var var::operator/(var n) {
+    inline var var::operator/(const var& n) {
         check_is_initialized();
+
+        if (auto f = infix_table::find(op_code::DIV_op, _self->_tag, n.type_id())) {
+            return f(*this, n);
+        }
+        detach();
         return _self->_div(n);
     }
 
-    inline var var::operator%(var n) {
+    inline var var::operator%(const var& n) {
         check_is_initialized();
+
+        if (auto f = infix_table::find(op_code::MOD_op, _self->_tag, n.type_id())) {
+            return f(*this, n);
+        }
+        detach();
         return _self->_mod(n);
     }
 
-    inline var var::pow(var n) {
+    inline var var::f_div(const var& n) {
         check_is_initialized();
-        return _self->_pow(n);
+
+        if (auto f = infix_table::find(op_code::FDIV_op, _self->_tag, n.type_id())) {
+            return f(*this, n);
+        }
+        detach();
+        return _self->_f_div(n);
+    }
+
+    inline var var::rem(const var& n) {
+        check_is_initialized();
+
+        if (auto f = infix_table::find(op_code::REM_op, _self->_tag, n.type_id())) {
+            return f(*this, n);
+        }
+        detach();
+        return _self->_rem(n);
+    }
+
+    inline var var::elementwise(op_code op, const var& n) {
+        detach();
+        return _self->_elementwise(op, n);
     }
 
-    inline var var::root(var n) {
+    inline var var::pow(const var& n) {
         check_is_initialized();
+
+        if (auto f = infix_table::find(op_code::EXP_op, _self->_tag, n.type_id())) {
+            return f(*this, n);
+        }
+        detach();
+        return _self->_pow(n);
+    }
+
+    inline var var::root(const var& n) {
+        check_is_initialized();  // Only reads the payload, so it is not detached.
         return _self->_root(n);
     }
 
     inline var var::real() {
-        check_is_initialized();
+        check_is_initialized();  // Only reads the payload, so it is not detached.
         return _self->_real();
     }
 
     inline var var::imag() {
-        check_is_initialized();
+        check_is_initialized();  // Only reads the payload, so it is not detached.
         return _self->_imag();
     }
 
     inline var var::abs() {
-        check_is_initialized();
+        check_is_initialized();  // Only reads the payload, so it is not detached.
         return _self->_abs();
     }
 
+    inline var var::exp() {
+        check_is_initialized();  // Only reads the payload, so it is not detached.
+        return _self->_exp();
+    }
+
+    inline var var::log() {
+        check_is_initialized();  // Only reads the payload, so it is not detached.
+        return _self->_log();
+    }
+
+    inline var var::sin() {
+        check_is_initialized();  // Only reads the payload, so it is not detached.
+        return _self->_sin();
+    }
+
+    inline var var::cos() {
+        check_is_initialized();  // Only reads the payload, so it is not detached.
+        return _self->_cos();
+    }
+
+    inline var var::tan() {
+        check_is_initialized();  // Only reads the payload, so it is not detached.
+        return _self->_tan();
+    }
+
+    inline var var::sinh() {
+        check_is_initialized();  // Only reads the payload, so it is not detached.
+        return _self->_sinh();
+    }
+
+    inline var var::cosh() {
+        check_is_initialized();  // Only reads the payload, so it is not detached.
+        return _self->_cosh();
+    }
+
+    inline var var::tanh() {
+        check_is_initialized();  // Only reads the payload, so it is not detached.
+        return _self->_tanh();
+    }
+
     inline var var::lead() {
-        check_is_initialized();
+        check_is_initialized();  // Only reads the payload, so it is not detached.
         return _self->_lead();
     }
 
-    inline var var::push(var n) {
-        check_is_initialized();
+    inline var var::push(const var& n) {
+        detach();
         return _self->_push(n);
     }
 
+    inline var var::push(var&& n) {
+        detach();
+        return _self->_push(std::move(n));
+    }
+
     inline var var::shift() {
-        check_is_initialized();
+        detach();
         return _self->_shift();
     }
 
     inline var var::drop() {
-        check_is_initialized();
+        detach();
         return _self->_drop();
     }
 
     inline var var::reverse() {
-        check_is_initialized();
+        detach();
         return _self->_reverse();
     }
 
-    inline var var::get(var n) {
-        check_is_initialized();
+    inline var var::get(const var& n) {
+        check_is_initialized();  // Only reads the payload, so it is not detached.
         return _self->_get(n);
     }
 
-    inline var var::set(var i, var n) {
-        check_is_initialized();
+    inline var var::set(const var& i, const var& n) {
+        detach();
         return _self->_set(i, n);
     }
 
-    inline var var::del(var n) {
-        check_is_initialized();
+    inline var var::set(const var& i, var&& n) {
+        detach();
+        return _self->_set(i, std::move(n));
+    }
+
+    inline var var::del(const var& n) {
+        detach();
         return _self->_del(n);
     }
 
-    inline var var::has(var n) {
-        check_is_initialized();
+    inline var var::has(const var& n) {
+        check_is_initialized();  // Only reads the payload, so it is not detached.
         return _self->_has(n);
     }
 
     inline  constexpr void var::check_is_initialized() {
         if (not _self) {
-            _self = std::make_unique<data_type<nothing>>(nothing());
+            emplace(nothing());
         }
     }
 
@@ -950,7 +1597,8 @@ namespace Oliver {
     /********************************************************************************************/
 
     template <typename T>
-    inline var::data_type<T>::data_type(T val) : _data(std::move(val)) {
+    template <typename U>
+    inline var::data_type<T>::data_type(U&& val) : interface_type(type_id_of<T>()), _data(std::forward<U>(val)) {
     }
 
     template<typename T>
@@ -993,7 +1641,12 @@ namespace Oliver {
     }
 
     template <typename T>
-    inline order var::data_type<T>::_comp(var n) const {
+    inline void var::data_type<T>::_write(fmt::memory_buffer& out, const Format_Args& fmt) const {
+        _write_(_data, out, fmt);
+    }
+
+    template <typename T>
+    inline order var::data_type<T>::_comp(const var& n) const {
         return _comp_(_data, n);
     }
 
@@ -1008,17 +1661,17 @@ namespace Oliver {
     }
 
     template <typename T>
-    inline var var::data_type<T>::_and(var n) {
+    inline var var::data_type<T>::_and(const var& n) {
         return _and_(_data, n);
     }
 
     template <typename T>
-    inline var var::data_type<T>::_or(var n) {
+    inline var var::data_type<T>::_or(const var& n) {
         return _or_(_data, n);
     }
 
     template <typename T>
-    inline var var::data_type<T>::_xor(var n) {
+    inline var var::data_type<T>::_xor(const var& n) {
         return _xor_(_data, n);
     }
 
@@ -1033,65 +1686,130 @@ namespace Oliver {
     }
 
     template <typename T>
-    inline var var::data_type<T>::_add(var n) {
+    inline var var::data_type<T>::_add(const var& n) {
         return _add_(_data, n);
     }
 
     template <typename T>
-    inline var var::data_type<T>::_sub(var n) {
+    inline var var::data_type<T>::_add(var&& n) {
+        return _add_(_data, std::move(n));
+    }
+
+    template <typename T>
+    inline var var::data_type<T>::_sub(const var& n) {
         return _sub_(_data, n);
     }
 
     template <typename T>
-    inline var var::data_type<T>::_mul(var n) {
+    inline var var::data_type<T>::_mul(const var& n) {
         return _mul_(_data, n);
     }
 
     template <typename T>
-    inline var var::data_type<T>::_div(var n) {
+    inline var var::data_type<T>::_div(const var& n) {
         return _div_(_data, n);
     }
 
     template <typename T>
-    inline var var::data_type<T>::_mod(var n) {
+    inline var var::data_type<T>::_mod(const var& n) {
         return _mod_(_data, n);
     }
 
     template <typename T>
-    inline var var::data_type<T>::_pow(var n) {
+    inline var var::data_type<T>::_f_div(const var& n) {
+        return _f_div_(_data, n);
+    }
+
+    template <typename T>
+    inline var var::data_type<T>::_rem(const var& n) {
+        return _rem_(_data, n);
+    }
+
+    template <typename T>
+    inline var var::data_type<T>::_elementwise(op_code op, const var& n) {
+        return _elementwise_(_data, op, n);
+    }
+
+    template <typename T>
+    inline var var::data_type<T>::_pow(const var& n) {
         return _pow_(_data, n);
     }
 
     template <typename T>
-    inline var var::data_type<T>::_root(var n) {
+    inline var var::data_type<T>::_root(const var& n) const {
         return _root_(_data, n);
     }
 
     template <typename T>
-    inline var var::data_type<T>::_real() {
+    inline var var::data_type<T>::_real() const {
         return _real_(_data);
     }
 
     template <typename T>
-    inline var var::data_type<T>::_imag() {
+    inline var var::data_type<T>::_imag() const {
         return _imag_(_data);
     }
 
     template <typename T>
-    inline var var::data_type<T>::_abs() {
+    inline var var::data_type<T>::_abs() const {
         return _abs_(_data);
     }
 
+    template <typename T>
+    inline var var::data_type<T>::_exp() const {
+        return _exp_(_data);
+    }
+
+    template <typename T>
+    inline var var::data_type<T>::_log() const {
+        return _log_(_data);
+    }
+
+    template <typename T>
+    inline var var::data_type<T>::_sin() const {
+        return _sin_(_data);
+    }
+
+    template <typename T>
+    inline var var::data_type<T>::_cos() const {
+        return _cos_(_data);
+    }
+
+    template <typename T>
+    inline var var::data_type<T>::_tan() const {
+        return _tan_(_data);
+    }
+
+    template <typename T>
+    inline var var::data_type<T>::_sinh() const {
+        return _sinh_(_data);
+    }
+
+    template <typename T>
+    inline var var::data_type<T>::_cosh() const {
+        return _cosh_(_data);
+    }
+
+    template <typename T>
+    inline var var::data_type<T>::_tanh() const {
+        return _tanh_(_data);
+    }
+
     template<typename T>
-    inline var var::data_type<T>::_lead() {
+    inline var var::data_type<T>::_lead() const {
         return _lead_(_data);
     }
 
     template <typename T>
-    inline var var::data_type<T>::_push(var n) {
+    inline var var::data_type<T>::_push(const var& n) {
         return _push_(_data, n);
     }
 
+    template <typename T>
+    inline var var::data_type<T>::_push(var&& n) {
+        return _push_(_data, std::move(n));
+    }
+
     template <typename T>
     inline var var::data_type<T>::_shift() {
         return _shift_(_data);
@@ -1108,31 +1826,180 @@ namespace Oliver {
     }
 
     template <typename T>
-    inline var var::data_type<T>::_get(var n) {
+    inline var var::data_type<T>::_get(const var& n) const {
         return _get_(_data, n);
     }
 
     template <typename T>
-    inline var var::data_type<T>::_set(const var& i, var n) {
+    inline var var::data_type<T>::_set(const var& i, const var& n) {
         return _set_(_data, i, n);
     }
 
     template <typename T>
-    inline var var::data_type<T>::_del(var n) {
+    inline var var::data_type<T>::_set(const var& i, var&& n) {
+        return _set_(_data, i, std::move(n));
+    }
+
+    template <typename T>
+    inline var var::data_type<T>::_del(const var& n) {
         return _del_(_data, n);
     }
 
     template <typename T>
-    inline var var::data_type<T>::_has(var n) {
+    inline var var::data_type<T>::_has(const var& n) const {
         return _has_(_data, n);
     }
 
     template<typename T>
-    inline std::unique_ptr<var::interface_type> var::data_type<T>::clone() const {
-        return std::make_unique<data_type<T>>(_data);
+    inline var::interface_type* var::data_type<T>::clone_to(void* local) const {
+        if constexpr (is_local<T>) {
+            return ::new (local) data_type<T>(_data);
+        }
+        else {
+            return new data_type<T>(_data);
+        }
+    }
+
+    template<typename T>
+    inline void* var::data_type<T>::operator new(std::size_t size) {
+        return node_pool::allocate(size);
+    }
+
+    template<typename T>
+    inline void var::data_type<T>::operator delete(void* ptr, std::size_t size) noexcept {
+        node_pool::deallocate(ptr, size);
+    }
+
+    template<typename T>
+    inline var::interface_type* var::data_type<T>::move_to(void* local) noexcept {
+        if constexpr (is_local<T>) {
+            return ::new (local) data_type<T>(std::move(_data));
+        }
+        else {
+            return this;
+        }
+    }
+
+    /********************************************************************************************/
+    //
+    //                                'infix_table' Class Implementation
+    //
+    /********************************************************************************************/
+
+    inline constexpr std::size_t infix_table::index(op_code op, type_id_t left, type_id_t right) noexcept {
+        const auto i = static_cast<std::size_t>(op) - static_cast<std::size_t>(op_code::INFIX_OPERATORS_START) - 1;
+        return (i * type_count + left) * type_count + right;
+    }
+
+    /*
+        A function local static, so the rules are defined on first use, even
+        during the static initialization of another translation unit.
+    */
+    inline void infix_table::rules_defined() noexcept {
+        static const bool defined = (define_infix_rules(), true);
+        (void)defined;
+    }
+
+    inline infix_function infix_table::find(op_code op, type_id_t left, type_id_t right) noexcept {
+
+        rules_defined();
+
+        if (left >= type_count || right >= type_count || op <= op_code::INFIX_OPERATORS_START || op >= op_code::INFIX_OPERATORS_STOP) {
+            return nullptr;
+        }
+        return _functions[index(op, left, right)];
+    }
+
+    template<op_code Op, typename L, typename R, typename C>
+    inline void infix_table::define() {
+        static_assert(is_registered_type<L> && is_registered_type<R>, "Only registered types have infix table entries.");
+        static_assert(Op > op_code::INFIX_OPERATORS_START && Op < op_code::INFIX_OPERATORS_STOP, "Not an infix operator.");
+
+        _functions[index(Op, type_id_of<L>(), type_id_of<R>())] = &apply<Op, L, R, C>;
+    }
+
+    inline compare_function infix_table::find_comparison(type_id_t left, type_id_t right) noexcept {
+
+        rules_defined();
+
+        if (left >= type_count || right >= type_count) {
+            return nullptr;
+        }
+        return _comparisons[left * type_count + right];
+    }
+
+    template<typename L, typename R, typename C>
+    inline void infix_table::define_comparison() {
+        static_assert(is_registered_type<L> && is_registered_type<R>, "Only registered types have infix table entries.");
+
+        _comparisons[type_id_of<L>() * type_count + type_id_of<R>()] = &compare<L, R, C>;
+    }
+
+    template<op_code Op, typename C>
+    inline var infix_table::kernel(const C& self, const C& other) {
+
+        if constexpr (Op == op_code::AND_op) { return _and_(self, other); }
+        else if constexpr (Op == op_code::OR_op) { return _or_(self, other); }
+        else if constexpr (Op == op_code::XOR_op) { return _xor_(self, other); }
+        else if constexpr (Op == op_code::ADD_op) { return _add_(self, other); }
+        else if constexpr (Op == op_code::SUB_op) { return _sub_(self, other); }
+        else if constexpr (Op == op_code::MUL_op) { return _mul_(self, other); }
+        else if constexpr (Op == op_code::DIV_op) { return _div_(self, other); }
+        else if constexpr (Op == op_code::MOD_op) { return _mod_(self, other); }
+        else if constexpr (Op == op_code::FDIV_op) { return _f_div_(self, other); }
+        else if constexpr (Op == op_code::REM_op) { return _rem_(self, other); }
+        else if constexpr (Op == op_code::EXP_op) { return _pow_(self, other); }
+        else {
+            static_assert(Op == op_code::AND_op, "No kernel is defined for this infix operator.");
+        }
+    }
+
+    template<op_code Op, typename L, typename R, typename C>
+    inline var infix_table::apply(const var& self, const var& other) {
+
+        const L& x = static_cast<const var::data_type<L>*>(self._self)->_data;
+        const R& y = static_cast<const var::data_type<R>*>(other._self)->_data;
+
+        if constexpr (std::is_same_v<L, C> && std::is_same_v<R, C>) {
+            return kernel<Op, C>(x, y);
+        }
+        else if constexpr (std::is_same_v<L, C>) {
+            return kernel<Op, C>(x, _promote_<C>(y));
+        }
+        else {
+            const C a = _promote_<C>(x);
+
+            if constexpr (std::is_same_v<R, C>) {
+                return kernel<Op, C>(a, y);
+            }
+            else {
+                return kernel<Op, C>(a, _promote_<C>(y));
+            }
+        }
+    }
+
+    template<typename L, typename R, typename C>
+    inline order infix_table::compare(const var& self, const var& other) {
+
+        const L& x = static_cast<const var::data_type<L>*>(self._self)->_data;
+        const R& y = static_cast<const var::data_type<R>*>(other._self)->_data;
+
+        if constexpr (std::is_same_v<L, C> && std::is_same_v<R, C>) {
+            return _comp_(x, y);
+        }
+        else if constexpr (std::is_same_v<L, C>) {
+            return _comp_(x, _promote_<C>(y));
+        }
+        else if constexpr (std::is_same_v<R, C>) {
+            return _comp_(_promote_<C>(x), y);
+        }
+        else {
+            return _comp_(_promote_<C>(x), _promote_<C>(y));
+        }
     }
 }
 
+
 /********************************************************************************************/
 //
 //                               fmt - Format Implementations
@@ -1150,9 +2017,11 @@ struct fmt::formatter<Oliver::var> : fmt::formatter<std::string_view> {
 
     auto format(const Oliver::var& a, fmt::format_context& ctx) const {
 
-        std::string result = a.str(fmt_args);
+        fmt::memory_buffer buffer;
+
+        a.write(buffer, fmt_args);
 
-        return fmt::format_to(ctx.out(), "{}", result);
+        return std::copy(buffer.begin(), buffer.end(), ctx.out());
     }
 };
 
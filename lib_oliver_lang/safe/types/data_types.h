@@ -37,10 +37,64 @@
 #include "List.h"
 //#include "Object.h"
 #include "Format.h"
+#include "Value.h"
 
 
 namespace Oliver {
 
+    /********************************************************************************************/
+    //
+    //                              Infix Operator Dispatch Rules
+    //
+    //          Defines the entries of the 'infix_table'.  Each rule names the operator,
+    //          the left and right operand types, and the type both are promoted to
+    //          before the typed kernel is applied.  A boolean promotes to the number
+    //          zero or one when combined with a number.  Any other mixed pair, such as
+    //          text and number, is left undefined and returns nothing.
+    //
+    //          Comparisons are defined between values of the same type only, so a
+    //          number and a boolean remain unordered.
+    //
+    /********************************************************************************************/
+
+    template<>
+    inline number _promote_<number, boolean>(const boolean& self) {
+        return number(_is_(self) ? 1ll : 0ll);
+    }
+
+    template<typename L, typename R, typename C = L>
+    inline void define_arithmetic_rules() {
+        infix_table::define<op_code::ADD_op, L, R, C>();
+        infix_table::define<op_code::SUB_op, L, R, C>();
+        infix_table::define<op_code::MUL_op, L, R, C>();
+        infix_table::define<op_code::DIV_op, L, R, C>();
+        infix_table::define<op_code::MOD_op, L, R, C>();
+        infix_table::define<op_code::FDIV_op, L, R, C>();
+        infix_table::define<op_code::REM_op, L, R, C>();
+        infix_table::define<op_code::EXP_op, L, R, C>();
+    }
+
+    template<typename L, typename R, typename C = L>
+    inline void define_logical_rules() {
+        infix_table::define<op_code::AND_op, L, R, C>();
+        infix_table::define<op_code::OR_op,  L, R, C>();
+        infix_table::define<op_code::XOR_op, L, R, C>();
+    }
+
+    inline void define_infix_rules() {
+
+        define_arithmetic_rules<number,  number>();
+        define_arithmetic_rules<number,  boolean, number>();
+        define_arithmetic_rules<boolean, number,  number>();
+
+        define_logical_rules<boolean, boolean>();
+
+        infix_table::define_comparison<number,  number>();
+        infix_table::define_comparison<boolean, boolean>();
+        infix_table::define_comparison<text,    text>();
+        infix_table::define_comparison<symbol,  symbol>();
+    }
+
 	//using order = std::partial_ordering;
 
  //   const enum class op_code;
@@ -0,0 +1,299 @@
+#pragma once
+
+/*****************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//        This program is free software : you can redistribute it and /or modify
+//        it under the terms of the GNU Affero General Public License as published by
+//        the Free Software Foundation, either version 3 of the License, or
+//        (at your option) any later version.
+//
+//        This program is distributed in the hope that it will be useful,
+//        but WITHOUT ANY WARRANTY; without even the implied warranty of
+//        MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//        GNU Affero General Public License for more details.
+//
+//        You should have received a copy of the GNU Affero General Public License
+//        along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//        The author can be reached at: maxjmartin@gmail.com
+//
+/*****************************************************************************************/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include <boost/multiprecision/cpp_int.hpp>
+
+/*
+    The cutoffs are in bits, of the smaller operand for multiplication and of
+    the divisor for division.  Below them the Boost.Multiprecision kernels are
+    used directly, which are already Karatsuba above 'BOOST_MP_KARATSUBA_CUTOFF'
+    limbs.  They may be overridden when building, to tune for a target machine.
+*/
+#ifndef OLIVER_TOOM3_CUTOFF
+#define OLIVER_TOOM3_CUTOFF     32768
+#endif
+
+#ifndef OLIVER_NEWTON_CUTOFF
+#define OLIVER_NEWTON_CUTOFF    8192
+#endif
+
+/*
+    The largest exact power, in bits.  A power certain to be larger is not
+    computed exactly, 'number' falls back on its real value instead.
+*/
+#ifndef OLIVER_MAX_POWER_BITS
+#define OLIVER_MAX_POWER_BITS   (1 << 22)
+#endif
+
+namespace Oliver {
+
+    /********************************************************************************************/
+    //
+    //                                Big Integer Arithmetic
+    //
+    //        Subquadratic kernels for the arbitrary precision integers of 'number'.
+    //
+    //        'big_multiply' is Toom-3 above its cutoff, splitting each operand into
+    //        three parts and recombining five half-size products, (Bodrato's sequence).
+    //
+    //        'big_divide' computes a fixed point reciprocal of the divisor by Newton
+    //        iteration, doubling its precision at each step, then divides in blocks
+    //        of the divisor's width.  So a division costs a few multiplications.
+    //
+    //        'big_power' raises to an unsigned exponent by repeated squaring.
+    //        'big_power_fits' tells whether the power is within the exact limit.
+    //
+    //        Each works on any signed Boost.Multiprecision integer type, and gives
+    //        the same results as the built in operators.
+    //
+    /********************************************************************************************/
+
+    template<typename Int>
+    std::size_t big_bits(const Int& x) {
+
+        if (x.is_zero()) {
+            return 0;
+        }
+
+        return (x.sign() < 0 ? boost::multiprecision::msb(Int(-x)) : boost::multiprecision::msb(x)) + 1;
+    }
+
+    template<typename Int>
+    Int big_multiply(const Int& a, const Int& b);
+
+    template<typename Int>
+    Int toom3_multiply(const Int& a, const Int& b) {
+
+        // Split into three parts of 'k' bits, 'a = a2 * X^2 + a1 * X + a0', with 'X = 2^k'.
+        const std::size_t k = (std::max(big_bits(a), big_bits(b)) + 2) / 3;
+
+        const Int mask = (Int(1) << k) - 1;
+
+        const Int a0 = a & mask;
+        const Int a1 = (a >> k) & mask;
+        const Int a2 = a >> (2 * k);
+
+        const Int b0 = b & mask;
+        const Int b1 = (b >> k) & mask;
+        const Int b2 = b >> (2 * k);
+
+        // Evaluate at 0, 1, -1, -2 and infinity.
+        Int p = a0 + a2;
+        Int q = b0 + b2;
+
+        const Int a_1  = p + a1;
+        const Int a_m1 = p - a1;
+        const Int a_m2 = ((a_m1 + a2) << 1) - a0;
+
+        const Int b_1  = q + b1;
+        const Int b_m1 = q - b1;
+        const Int b_m2 = ((b_m1 + b2) << 1) - b0;
+
+        const Int r0   = big_multiply(a0, b0);
+        const Int r1   = big_multiply(a_1, b_1);
+        const Int r_m1 = big_multiply(a_m1, b_m1);
+        const Int r_m2 = big_multiply(a_m2, b_m2);
+        const Int r_oo = big_multiply(a2, b2);
+
+        // Interpolate, each division is exact.
+        Int c3 = (r_m2 - r1) / 3;
+        Int c1 = (r1 - r_m1) >> 1;
+        Int c2 = r_m1 - r0;
+
+        c3 = ((c2 - c3) >> 1) + (r_oo << 1);
+        c2 = c2 + c1 - r_oo;
+        c1 = c1 - c3;
+
+        Int result = r_oo;
+
+        result <<= k;
+        result  += c3;
+        result <<= k;
+        result  += c2;
+        result <<= k;
+        result  += c1;
+        result <<= k;
+        result  += r0;
+
+        return result;
+    }
+
+    template<typename Int>
+    Int big_multiply(const Int& a, const Int& b) {
+
+        if (std::min(big_bits(a), big_bits(b)) < OLIVER_TOOM3_CUTOFF) {
+            return a * b;
+        }
+
+        // Toom-3 is applied to the magnitudes, the differences at -1 and -2 may
+        // be negative, so the sign is restored afterward.
+        const bool negative = (a.sign() < 0) != (b.sign() < 0);
+
+        Int result = toom3_multiply(Int(abs(a)), Int(abs(b)));
+
+        return negative ? Int(-result) : result;
+    }
+
+    /*
+        The reciprocal 'floor(2^(2n) / b)' of an 'n' bit divisor.  The
+        reciprocal of the divisor's upper half is scaled up as the estimate,
+        and one Newton step, 'x + x * (2^(2n) - b * x) / 2^(2n)', doubles its
+        precision.  The remaining error is a few units, removed by correction.
+    */
+    template<typename Int>
+    Int big_reciprocal(const Int& b, std::size_t n) {
+
+        if (n < OLIVER_NEWTON_CUTOFF) {
+            return (Int(1) << (2 * n)) / b;
+        }
+
+        const std::size_t h = n / 2 + 1;
+
+        Int x = big_reciprocal(Int(b >> (n - h)), h) << (n - h);
+
+        const Int one = Int(1) << (2 * n);
+
+        Int e = one - big_multiply(b, x);
+
+        x += big_multiply(x, e) >> (2 * n);
+
+        e = one - big_multiply(b, x);
+
+        while (e.sign() < 0) {
+            --x;
+            e += b;
+        }
+
+        while (e >= b) {
+            ++x;
+            e -= b;
+        }
+
+        return x;
+    }
+
+    /*
+        Divides a non-negative 'a' less than 'b * 2^n', by the 'n' bit 'b', with
+        its reciprocal 'r'.  Only the upper bits of 'a' are needed for the estimate.
+    */
+    template<typename Int>
+    void big_divide_block(const Int& a, const Int& b, const Int& r, std::size_t n, Int& q, Int& rem) {
+
+        q   = big_multiply(Int(a >> (n - 1)), r) >> (n + 1);
+        rem = a - big_multiply(q, b);
+
+        while (rem.sign() < 0) {
+            --q;
+            rem += b;
+        }
+
+        while (rem >= b) {
+            ++q;
+            rem -= b;
+        }
+    }
+
+    /*
+        The truncated quotient and remainder, as 'boost::multiprecision::divide_qr'.
+        The divisor must not be zero.
+    */
+    template<typename Int>
+    void big_divide(const Int& a, const Int& b, Int& q, Int& rem) {
+
+        const std::size_t n = big_bits(b);
+
+        if (n < OLIVER_NEWTON_CUTOFF || big_bits(a) < n + OLIVER_NEWTON_CUTOFF / 2) {
+            boost::multiprecision::divide_qr(a, b, q, rem);
+            return;
+        }
+
+        const Int x = abs(a);
+        const Int y = abs(b);
+        const Int r = big_reciprocal(y, n);
+
+        // Long division, with each digit a block of 'n' bits, from the top.
+        const std::size_t blocks = (big_bits(x) + n - 1) / n;
+        const Int         mask   = (Int(1) << n) - 1;
+
+        q   = 0;
+        rem = 0;
+
+        for (std::size_t i = blocks; i-- > 0;) {
+
+            Int digit;
+
+            big_divide_block(Int((rem << n) | ((x >> (i * n)) & mask)), y, r, n, digit, rem);
+
+            q <<= n;
+            q  += digit;
+        }
+
+        if ((a.sign() < 0) != (b.sign() < 0)) {
+            q = -q;
+        }
+
+        if (a.sign() < 0) {
+            rem = -rem;
+        }
+    }
+
+    /*
+        A base of 'b' bits is at least '2^(b - 1)', so its power has at least
+        '(b - 1) * e' bits.  Bases of 0, 1 and -1 fit for any exponent.
+    */
+    template<typename Int>
+    bool big_power_fits(const Int& base, std::uint64_t e) {
+
+        const std::size_t bits = big_bits(base);
+
+        return bits <= 1 || e <= OLIVER_MAX_POWER_BITS / (bits - 1);
+    }
+
+    template<typename Int>
+    Int big_power(Int base, std::uint64_t e) {
+
+        Int result = 1;
+
+        while (e) {
+
+            if (e & 1) {
+                result = big_multiply(result, base);
+            }
+
+            e >>= 1;
+
+            if (e) {
+                base = big_multiply(base, base);
+            }
+        }
+
+        return result;
+    }
+}
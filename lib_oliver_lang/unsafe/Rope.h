@@ -0,0 +1,712 @@
+#pragma once
+
+/*****************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//        This program is free software : you can redistribute it and /or modify
+//        it under the terms of the GNU Affero General Public License as published by
+//        the Free Software Foundation, either version 3 of the License, or
+//        (at your option) any later version.
+//
+//        This program is distributed in the hope that it will be useful,
+//        but WITHOUT ANY WARRANTY; without even the implied warranty of
+//        MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//        GNU Affero General Public License for more details.
+//
+//        You should have received a copy of the GNU Affero General Public License
+//        along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//        The author can be reached at: maxjmartin@gmail.com
+//
+/*****************************************************************************************/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/*
+    A rope no larger than the chunk size is held in a string of its own, and
+    only becomes a tree once it grows past it.  Adjacent pieces which together
+    fit within the chunk size are copied into one buffer, so a rope built a
+    character at a time holds chunks rather than characters.
+*/
+#ifndef OLIVER_ROPE_CHUNK
+#define OLIVER_ROPE_CHUNK   512
+#endif
+
+namespace Oliver {
+
+    /********************************************************************************************/
+    //
+    //                                 'rope' Class Definition
+    //
+    //        A persistent, height balanced (AVL) binary tree of text.  Each leaf is a
+    //        piece, a range of an immutable character buffer shared by reference.
+    //        Nodes are never modified once built, so copying a rope copies a pointer,
+    //        and an edit builds a new path to the root, sharing the remainder.
+    //
+    //        Concatenation joins two trees at the height of the shorter, and 'substr'
+    //        descends to the range, joining the pieces either side of the subtree
+    //        which straddles it.  Both are O(log n), and the pieces of a substring
+    //        reference the buffers of its parent.
+    //
+    //        Iterating visits each piece in turn, so stepping to the next character is
+    //        O(1) amortized, and copies nothing.
+    //
+    //        A rope no larger than a chunk is not a tree, but a 'std::pmr::string'.
+    //        So a short text, or a short slice of a long one, allocates no nodes,
+    //        and nothing at all when the string fits its small buffer.
+    //
+    //        Nodes and buffers are allocated from the memory resource the rope was
+    //        constructed with.  A rope joined with, or assigned, one from another
+    //        resource copies it first, so no rope references memory from a resource
+    //        other than its own.
+    //
+    /********************************************************************************************/
+
+    class rope {
+
+        struct node;
+        class chunks;
+
+        using node_ptr = std::shared_ptr<const node>;
+
+    public:
+
+        using size_type = std::size_t;
+
+        class const_iterator;
+
+        static constexpr size_type npos       = static_cast<size_type>(-1);
+        static constexpr size_type chunk_size = OLIVER_ROPE_CHUNK;
+
+        rope()                                                    noexcept;
+        explicit rope(std::pmr::memory_resource* resource)       noexcept;
+        rope(std::string_view str, std::pmr::memory_resource* resource);
+        rope(const rope& other);
+        rope(rope&& other)                                        noexcept;
+
+        rope& operator=(const rope& other);
+        rope& operator=(rope&& other);
+
+        size_type                       size() const noexcept;
+        bool                           empty() const noexcept;
+        bool                         is_flat() const noexcept;  // Is the rope a single buffer, rather than a tree?
+        bool                        balanced() const noexcept;  // Do the children of every branch differ in height by at most one?
+        std::pmr::memory_resource*  resource() const noexcept;
+
+        char                     at(size_type i)                       const;  // O(log n).
+        rope                 substr(size_type pos, size_type n = npos) const;  // O(log n), sharing the buffers.
+
+        rope&                append(const rope& other);  // O(log n).
+        rope&               prepend(const rope& other);  // O(log n).
+
+        std::string_view       view();  // Flatten a tree into one buffer, only if not already flat.
+        std::string             str() const;
+        int                 compare(const rope& other) const;
+
+        template<typename F>
+        void         for_each_chunk(F f) const;  // Call 'f' with each piece, in order.
+
+        const_iterator        begin() const;
+        const_iterator          end() const noexcept;
+
+    private:
+
+        struct node {
+            node_ptr                      left;
+            node_ptr                      right;
+            std::shared_ptr<const char[]> buffer;  // Leaves only.
+            const char*                   data   = nullptr;
+            size_type                     size   = 0;
+            std::uint8_t                  height = 0;  // Zero for a leaf.
+
+            node(std::shared_ptr<const char[]> buf, const char* first, size_type n);
+            node(node_ptr l, node_ptr r);
+        };
+
+        // The pieces of a tree, in order.
+        class chunks {
+        public:
+            explicit chunks(const node* root, std::string_view small = {});
+
+            std::string_view next();  // Empty once every piece has been visited.
+
+        private:
+            std::vector<const node*> _stack;
+            const node*              _leaf = nullptr;
+            std::string_view         _small;  // The whole of a rope which is not a tree.
+
+            void descend(const node* t);
+        };
+
+        std::pmr::memory_resource* _resource;
+        node_ptr                   _root;   // Only when larger than a chunk.
+        std::pmr::string           _small;  // Otherwise.
+
+        explicit rope(node_ptr root, std::pmr::memory_resource* resource);
+
+        rope          imported(const rope& other) const;  // 'other', within this rope's resource.
+        node_ptr          tree(const rope& other) const;  // 'other' as a tree, within this rope's resource.
+        void           release();                         // Let go of the small string, once a tree.
+
+        static void       copy(const node* t, size_type pos, size_type n, std::pmr::string& out);
+        static bool   balanced(const node* t) noexcept;
+
+        node_ptr          leaf(std::string_view a, std::string_view b = {}) const;  // Copy into a new buffer.
+        node_ptr         piece(const node& t, size_type pos, size_type n)  const;  // A range of a leaf's buffer.
+        node_ptr        branch(node_ptr l, node_ptr r)                      const;
+        node_ptr       balance(node_ptr l, node_ptr r)                      const;
+        node_ptr          join(node_ptr l, node_ptr r)                      const;
+        node_ptr         range(const node_ptr& t, size_type pos, size_type n) const;  // 'n' characters of 't', from 'pos'.
+    };
+
+    // A forward iterator over the characters of a rope, which must outlive it.
+    class rope::const_iterator {
+
+    public:
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = char;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const char*;
+        using reference         = const char&;
+
+        const_iterator() = default;
+
+        reference       operator*()  const noexcept;
+        const_iterator& operator++();
+        const_iterator  operator++(int);
+
+        bool operator==(const const_iterator& other) const noexcept;
+
+    private:
+
+        friend class rope;
+
+        chunks           _chunks{nullptr};
+        std::string_view _piece;
+        size_type        _pos = 0;  // Characters before the current one.
+
+        const_iterator(const node* root, std::string_view small, size_type size);
+    };
+
+    /********************************************************************************************/
+    //
+    //                                 'rope' Class Implementation
+    //
+    /********************************************************************************************/
+
+    inline rope::node::node(std::shared_ptr<const char[]> buf, const char* first, size_type n)
+        : buffer(std::move(buf)), data(first), size(n), height(0) {
+    }
+
+    inline rope::node::node(node_ptr l, node_ptr r)
+        : left(std::move(l)), right(std::move(r)) {
+        size   = left->size + right->size;
+        height = static_cast<std::uint8_t>(std::max(left->height, right->height) + 1);
+    }
+
+    inline rope::chunks::chunks(const node* root, std::string_view small) : _small(small) {
+        descend(root);
+    }
+
+    inline void rope::chunks::descend(const node* t) {
+
+        while (t && t->height) {
+            _stack.push_back(t->right.get());
+            t = t->left.get();
+        }
+
+        _leaf = t;
+    }
+
+    inline std::string_view rope::chunks::next() {
+
+        if (!_small.empty()) {
+            return std::exchange(_small, {});
+        }
+
+        if (!_leaf) {
+            return {};
+        }
+
+        std::string_view result(_leaf->data, _leaf->size);
+
+        _leaf = nullptr;
+
+        if (!_stack.empty()) {
+            const node* t = _stack.back();
+            _stack.pop_back();
+            descend(t);
+        }
+
+        return result;
+    }
+
+    inline rope::const_iterator::const_iterator(const node* root, std::string_view small, size_type size) : _pos(size) {
+
+        if (root || !small.empty()) {
+            _chunks = chunks(root, small);
+            _piece  = _chunks.next();
+            _pos    = 0;
+        }
+    }
+
+    inline rope::const_iterator::reference rope::const_iterator::operator*() const noexcept {
+        return _piece.front();
+    }
+
+    inline rope::const_iterator& rope::const_iterator::operator++() {
+
+        _piece.remove_prefix(1);
+        ++_pos;
+
+        if (_piece.empty()) {
+            _piece = _chunks.next();
+        }
+
+        return *this;
+    }
+
+    inline rope::const_iterator rope::const_iterator::operator++(int) {
+        const_iterator result = *this;
+        ++*this;
+        return result;
+    }
+
+    inline bool rope::const_iterator::operator==(const const_iterator& other) const noexcept {
+        return _pos == other._pos;
+    }
+
+    inline rope::rope() noexcept : rope(std::pmr::get_default_resource()) {
+    }
+
+    inline rope::rope(std::pmr::memory_resource* resource) noexcept : _resource(resource), _small(resource) {
+    }
+
+    inline rope::rope(std::string_view str, std::pmr::memory_resource* resource) : _resource(resource), _small(resource) {
+
+        if (str.size() > chunk_size) {
+            _root = leaf(str);
+        }
+        else {
+            _small = str;
+        }
+    }
+
+    inline rope::rope(const rope& other) : _resource(other._resource), _root(other._root), _small(other._small, other._resource) {
+    }
+
+    inline rope::rope(rope&& other) noexcept : _resource(other._resource), _root(std::move(other._root)), _small(std::move(other._small)) {
+    }
+
+    inline rope& rope::operator=(const rope& other) {
+
+        if (this != &other) {
+            rope x = imported(other);
+            _root  = std::move(x._root);
+            _small = std::move(x._small);  // Of the same resource, so the buffer is moved.
+        }
+
+        return *this;
+    }
+
+    inline rope& rope::operator=(rope&& other) {
+
+        if (this != &other) {
+
+            if (other._resource != _resource) {
+                return *this = std::as_const(other);
+            }
+
+            _root  = std::move(other._root);
+            _small = std::move(other._small);
+        }
+
+        return *this;
+    }
+
+    // A tree no larger than a chunk is copied into the small string.
+    inline rope::rope(node_ptr root, std::pmr::memory_resource* resource) : _resource(resource), _small(resource) {
+
+        if (root && root->size <= chunk_size) {
+            copy(root.get(), 0, root->size, _small);
+        }
+        else {
+            _root = std::move(root);
+        }
+    }
+
+    inline rope::size_type rope::size() const noexcept {
+        return _root ? _root->size : _small.size();
+    }
+
+    inline bool rope::empty() const noexcept {
+        return size() == 0;
+    }
+
+    inline bool rope::is_flat() const noexcept {
+        return !_root || !_root->height;
+    }
+
+    inline bool rope::balanced() const noexcept {
+        return !_root || balanced(_root.get());
+    }
+
+    inline std::pmr::memory_resource* rope::resource() const noexcept {
+        return _resource;
+    }
+
+    inline char rope::at(size_type i) const {
+
+        if (!_root) {
+            return _small[i];
+        }
+
+        const node* t = _root.get();
+
+        while (t->height) {
+
+            if (i < t->left->size) {
+                t = t->left.get();
+            }
+            else {
+                i -= t->left->size;
+                t = t->right.get();
+            }
+        }
+
+        return t->data[i];
+    }
+
+    inline rope rope::substr(size_type pos, size_type n) const {
+
+        pos = std::min(pos, size());
+        n   = std::min(n, size() - pos);
+
+        if (n > chunk_size) {
+            return rope(range(_root, pos, n), _resource);
+        }
+
+        rope result(_resource);
+
+        if (_root) {
+            copy(_root.get(), pos, n, result._small);
+        }
+        else {
+            result._small.assign(_small, pos, n);
+        }
+
+        return result;
+    }
+
+    inline rope& rope::append(const rope& other) {
+
+        if (size() + other.size() <= chunk_size) {
+            _small.append(other._small);  // Neither is a tree.
+        }
+        else {
+            _root = join(tree(*this), tree(other));
+            release();
+        }
+
+        return *this;
+    }
+
+    inline rope& rope::prepend(const rope& other) {
+
+        if (size() + other.size() <= chunk_size) {
+            _small.insert(0, other._small);
+        }
+        else {
+            _root = join(tree(other), tree(*this));
+            release();
+        }
+
+        return *this;
+    }
+
+    inline std::string_view rope::view() {
+
+        if (!_root) {
+            return _small;
+        }
+
+        if (_root->height) {
+            _root = leaf(str());
+        }
+
+        return std::string_view(_root->data, _root->size);
+    }
+
+    inline std::string rope::str() const {
+
+        if (!_root) {
+            return std::string(_small);
+        }
+
+        std::string result;
+
+        result.reserve(size());
+
+        for_each_chunk([&](std::string_view s) { result.append(s); });
+
+        return result;
+    }
+
+    inline int rope::compare(const rope& other) const {
+
+        if (_root && _root == other._root) {
+            return 0;
+        }
+
+        chunks a(_root.get(), _small);
+        chunks b(other._root.get(), other._small);
+
+        std::string_view x = a.next();
+        std::string_view y = b.next();
+
+        while (!x.empty() && !y.empty()) {
+
+            const size_type n = std::min(x.size(), y.size());
+
+            if (int c = std::char_traits<char>::compare(x.data(), y.data(), n)) {
+                return c;
+            }
+
+            x.remove_prefix(n);
+            y.remove_prefix(n);
+
+            if (x.empty()) {
+                x = a.next();
+            }
+
+            if (y.empty()) {
+                y = b.next();
+            }
+        }
+
+        return x.empty() ? (y.empty() ? 0 : -1) : 1;
+    }
+
+    template<typename F>
+    inline void rope::for_each_chunk(F f) const {
+
+        chunks c(_root.get(), _small);
+
+        for (std::string_view s = c.next(); !s.empty(); s = c.next()) {
+            f(s);
+        }
+    }
+
+    inline rope::const_iterator rope::begin() const {
+        return const_iterator(_root.get(), _small, 0);
+    }
+
+    inline rope::const_iterator rope::end() const noexcept {
+        return const_iterator(nullptr, {}, size());
+    }
+
+    inline rope rope::imported(const rope& other) const {
+
+        if (other._resource == _resource || other.empty()) {
+            return other;
+        }
+
+        return rope(other.str(), _resource);
+    }
+
+    inline rope::node_ptr rope::tree(const rope& other) const {
+
+        if (other._root) {
+            return other._resource == _resource ? other._root : imported(other)._root;
+        }
+
+        return other._small.empty() ? nullptr : leaf(other._small);
+    }
+
+    inline void rope::release() {
+        std::pmr::string(_resource).swap(_small);
+    }
+
+    // Appends 'n' characters of 't' to 'out', from 'pos'.
+    inline void rope::copy(const node* t, size_type pos, size_type n, std::pmr::string& out) {
+
+        while (t->height) {
+
+            const size_type k = t->left->size;
+
+            if (pos + n <= k) {
+                t = t->left.get();
+            }
+            else if (pos >= k) {
+                pos -= k;
+                t    = t->right.get();
+            }
+            else {
+                copy(t->left.get(), pos, k - pos, out);
+                n  -= k - pos;
+                pos = 0;
+                t   = t->right.get();
+            }
+        }
+
+        out.append(t->data + pos, n);
+    }
+
+    inline bool rope::balanced(const node* t) noexcept {
+
+        if (!t->height) {
+            return true;
+        }
+
+        const int l = t->left->height;
+        const int r = t->right->height;
+
+        return t->height == std::max(l, r) + 1 && l - r <= 1 && r - l <= 1
+            && t->size == t->left->size + t->right->size
+            && balanced(t->left.get()) && balanced(t->right.get());
+    }
+
+    inline rope::node_ptr rope::leaf(std::string_view a, std::string_view b) const {
+
+        const size_type n = a.size() + b.size();
+
+        auto buffer = std::allocate_shared<char[]>(std::pmr::polymorphic_allocator<char>(_resource), n);
+
+        std::copy(a.begin(), a.end(), buffer.get());
+        std::copy(b.begin(), b.end(), buffer.get() + a.size());
+
+        const char* data = buffer.get();
+
+        return std::allocate_shared<node>(std::pmr::polymorphic_allocator<node>(_resource), std::move(buffer), data, n);
+    }
+
+    inline rope::node_ptr rope::piece(const node& t, size_type pos, size_type n) const {
+        return std::allocate_shared<node>(std::pmr::polymorphic_allocator<node>(_resource), t.buffer, t.data + pos, n);
+    }
+
+    inline rope::node_ptr rope::branch(node_ptr l, node_ptr r) const {
+        return std::allocate_shared<node>(std::pmr::polymorphic_allocator<node>(_resource), std::move(l), std::move(r));
+    }
+
+    /*
+        Joins two balanced trees whose heights differ by at most two, rotating
+        the taller side once, or twice when its inner child is the taller.
+    */
+    inline rope::node_ptr rope::balance(node_ptr l, node_ptr r) const {
+
+        if (l->height > r->height + 1) {
+
+            if (l->left->height >= l->right->height) {
+                return branch(l->left, branch(l->right, std::move(r)));
+            }
+
+            const node& m = *l->right;
+
+            return branch(branch(l->left, m.left), branch(m.right, std::move(r)));
+        }
+
+        if (r->height > l->height + 1) {
+
+            if (r->right->height >= r->left->height) {
+                return branch(branch(std::move(l), r->left), r->right);
+            }
+
+            const node& m = *r->left;
+
+            return branch(branch(std::move(l), m.left), branch(m.right, r->right));
+        }
+
+        return branch(std::move(l), std::move(r));
+    }
+
+    /*
+        Descends the taller tree's inner edge to the height of the shorter, and
+        rebalances on the way back up.  So O(log n) nodes are built.
+    */
+    inline rope::node_ptr rope::join(node_ptr l, node_ptr r) const {
+
+        if (!l) {
+            return r;
+        }
+
+        if (!r) {
+            return l;
+        }
+
+        if (l->size + r->size <= chunk_size) {
+
+            if (!l->height && !r->height) {
+                return leaf(std::string_view(l->data, l->size), std::string_view(r->data, r->size));
+            }
+
+            std::pmr::string s(_resource);
+
+            s.reserve(l->size + r->size);
+
+            copy(l.get(), 0, l->size, s);
+            copy(r.get(), 0, r->size, s);
+
+            return leaf(s);
+        }
+
+        // Merging small pieces may leave the inner join shorter than expected,
+        // in which case it is joined again, rather than rotated.
+        if (l->height > r->height + 1) {
+
+            node_ptr inner = join(l->right, std::move(r));
+
+            return l->left->height > inner->height + 2 ? join(l->left, std::move(inner)) : balance(l->left, std::move(inner));
+        }
+
+        if (r->height > l->height + 1) {
+
+            node_ptr inner = join(std::move(l), r->left);
+
+            return r->right->height > inner->height + 2 ? join(std::move(inner), r->right) : balance(std::move(inner), r->right);
+        }
+
+        return branch(std::move(l), std::move(r));
+    }
+
+    /*
+        Only a subtree which straddles the range is divided, so a leaf builds
+        a single piece, and a branch joins a suffix of its left child to a
+        prefix of its right.
+    */
+    inline rope::node_ptr rope::range(const node_ptr& t, size_type pos, size_type n) const {
+
+        if (pos == 0 && n == t->size) {
+            return t;
+        }
+
+        if (!t->height) {
+            return piece(*t, pos, n);
+        }
+
+        const size_type k = t->left->size;
+
+        if (pos + n <= k) {
+            return range(t->left, pos, n);
+        }
+
+        if (pos >= k) {
+            return range(t->right, pos - k, n);
+        }
+
+        return join(range(t->left, pos, k - pos), range(t->right, 0, pos + n - k));
+    }
+}
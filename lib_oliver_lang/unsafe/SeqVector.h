@@ -41,6 +41,7 @@
 #include <type_traits>
 
 #include "Expression_Template.h"
+#include "Simd.h"
 #include <ostream>
 
 namespace Oliver {
@@ -382,6 +383,10 @@ namespace Oliver {
 
     template<typename VALUE>
     inline constexpr SeqVector<VALUE>& SeqVector<VALUE>::exp() {
+        if constexpr (std::is_same_v<VALUE, double>) {
+            simd_apply(lane_fn::exp, _sequence.data(), _sequence.data(), size());
+            return *this;
+        }
         for (std::size_t i = 0, limit = size(); i < limit; ++i) {
             _sequence[i] = std::exp(_sequence[i]);
         }
@@ -395,6 +400,10 @@ namespace Oliver {
 
     template<typename VALUE>
     inline constexpr SeqVector<VALUE>& SeqVector<VALUE>::log() {
+        if constexpr (std::is_same_v<VALUE, double>) {
+            simd_apply(lane_fn::log, _sequence.data(), _sequence.data(), size());
+            return *this;
+        }
         for (std::size_t i = 0, limit = size(); i < limit; ++i) {
             _sequence[i] = std::log(_sequence[i]);
         }
@@ -447,6 +456,10 @@ namespace Oliver {
 
     template<typename VALUE>
     inline constexpr SeqVector<VALUE>& SeqVector<VALUE>::sin() {
+        if constexpr (std::is_same_v<VALUE, double>) {
+            simd_apply(lane_fn::sin, _sequence.data(), _sequence.data(), size());
+            return *this;
+        }
         for (std::size_t i = 0, limit = size(); i < limit; ++i) {
             _sequence[i] = std::sin(_sequence[i]);
         }
@@ -460,6 +473,10 @@ namespace Oliver {
 
     template<typename VALUE>
     inline constexpr SeqVector<VALUE>& SeqVector<VALUE>::cos() {
+        if constexpr (std::is_same_v<VALUE, double>) {
+            simd_apply(lane_fn::cos, _sequence.data(), _sequence.data(), size());
+            return *this;
+        }
         for (std::size_t i = 0, limit = size(); i < limit; ++i) {
             _sequence[i] = std::cos(_sequence[i]);
         }
@@ -473,6 +490,10 @@ namespace Oliver {
 
     template<typename VALUE>
     inline constexpr SeqVector<VALUE>& SeqVector<VALUE>::tan() {
+        if constexpr (std::is_same_v<VALUE, double>) {
+            simd_apply(lane_fn::tan, _sequence.data(), _sequence.data(), size());
+            return *this;
+        }
         for (std::size_t i = 0, limit = size(); i < limit; ++i) {
             _sequence[i] = std::tan(_sequence[i]);
         }
@@ -538,6 +559,10 @@ namespace Oliver {
 
     template<typename VALUE>
     inline constexpr SeqVector<VALUE>& SeqVector<VALUE>::sinh() {
+        if constexpr (std::is_same_v<VALUE, double>) {
+            simd_apply(lane_fn::sinh, _sequence.data(), _sequence.data(), size());
+            return *this;
+        }
         for (std::size_t i = 0, limit = size(); i < limit; ++i) {
             _sequence[i] = std::sinh(_sequence[i]);
         }
@@ -554,6 +579,10 @@ namespace Oliver {
 
     template<typename VALUE>
     inline constexpr SeqVector<VALUE>& SeqVector<VALUE>::cosh() {
+        if constexpr (std::is_same_v<VALUE, double>) {
+            simd_apply(lane_fn::cosh, _sequence.data(), _sequence.data(), size());
+            return *this;
+        }
         for (std::size_t i = 0, limit = size(); i < limit; ++i) {
             _sequence[i] = std::cosh(_sequence[i]);
         }
@@ -567,6 +596,10 @@ namespace Oliver {
 
     template<typename VALUE>
     inline constexpr SeqVector<VALUE>& SeqVector<VALUE>::tanh() {
+        if constexpr (std::is_same_v<VALUE, double>) {
+            simd_apply(lane_fn::tanh, _sequence.data(), _sequence.data(), size());
+            return *this;
+        }
         for (std::size_t i = 0, limit = size(); i < limit; ++i) {
             _sequence[i] = std::tanh(_sequence[i]);
         }
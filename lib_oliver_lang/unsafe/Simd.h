@@ -0,0 +1,582 @@
+#pragma once
+
+/*****************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//        This program is free software : you can redistribute it and /or modify
+//        it under the terms of the GNU Affero General Public License as published by
+//        the Free Software Foundation, either version 3 of the License, or
+//        (at your option) any later version.
+//
+//        This program is distributed in the hope that it will be useful,
+//        but WITHOUT ANY WARRANTY; without even the implied warranty of
+//        MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//        GNU Affero General Public License for more details.
+//
+//        You should have received a copy of the GNU Affero General Public License
+//        along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//        The author can be reached at: maxjmartin@gmail.com
+//
+/*****************************************************************************************/
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include "Operator_Templates.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define OLIVER_SIMD_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OLIVER_SIMD_SSE2
+#endif
+
+namespace Oliver {
+
+    /********************************************************************************************/
+    //
+    //                                  SIMD Lane Kernels
+    //
+    //        Element-wise kernels over contiguous, unboxed buffers.  The operation
+    //        is a template argument, so each loop is branch free.  Four doubles are
+    //        processed at a time with AVX, two with SSE2, and the remainder with the
+    //        scalar 'Operator_Templates'.  IEEE arithmetic gives the same result in
+    //        a vector lane as in a scalar one.
+    //
+    //        A comparison writes 1.0 where it holds and 0.0 where it does not.  Only
+    //        'not equal' holds for a NaN operand.
+    //
+    //        The integer kernels only add, subtract and multiply.  They are written
+    //        as plain loops, which the compiler vectorizes, and do not check for
+    //        overflow, so the caller must ensure the operands are small enough.
+    //
+    /********************************************************************************************/
+
+    enum class lane_op : std::uint8_t { add, sub, mul, div, eq, ne, lt, le, gt, ge };
+
+    template<lane_op Op>
+    double scalar_lane(double a, double b) {
+
+        if constexpr (Op == lane_op::add) { return Add_Op<double>::apply(a, b); }
+        else if constexpr (Op == lane_op::sub) { return Sub_Op<double>::apply(a, b); }
+        else if constexpr (Op == lane_op::mul) { return Mul_Op<double>::apply(a, b); }
+        else if constexpr (Op == lane_op::div) { return Div_Op<double>::apply(a, b); }
+        else if constexpr (Op == lane_op::eq)  { return a == b; }
+        else if constexpr (Op == lane_op::ne)  { return a != b; }
+        else if constexpr (Op == lane_op::lt)  { return a <  b; }
+        else if constexpr (Op == lane_op::le)  { return a <= b; }
+        else if constexpr (Op == lane_op::gt)  { return a >  b; }
+        else                                   { return a >= b; }
+    }
+
+#if defined(OLIVER_SIMD_AVX)
+
+    template<lane_op Op>
+    __m256d vector_lane(__m256d a, __m256d b) {
+
+        if constexpr (Op == lane_op::add) { return _mm256_add_pd(a, b); }
+        else if constexpr (Op == lane_op::sub) { return _mm256_sub_pd(a, b); }
+        else if constexpr (Op == lane_op::mul) { return _mm256_mul_pd(a, b); }
+        else if constexpr (Op == lane_op::div) { return _mm256_div_pd(a, b); }
+        else {
+            constexpr int predicate = Op == lane_op::eq ? _CMP_EQ_OQ  : Op == lane_op::ne ? _CMP_NEQ_UQ
+                                    : Op == lane_op::lt ? _CMP_LT_OQ  : Op == lane_op::le ? _CMP_LE_OQ
+                                    : Op == lane_op::gt ? _CMP_GT_OQ  : _CMP_GE_OQ;
+
+            return _mm256_and_pd(_mm256_cmp_pd(a, b, predicate), _mm256_set1_pd(1.0));
+        }
+    }
+
+#elif defined(OLIVER_SIMD_SSE2)
+
+    template<lane_op Op>
+    __m128d vector_lane(__m128d a, __m128d b) {
+
+        if constexpr (Op == lane_op::add) { return _mm_add_pd(a, b); }
+        else if constexpr (Op == lane_op::sub) { return _mm_sub_pd(a, b); }
+        else if constexpr (Op == lane_op::mul) { return _mm_mul_pd(a, b); }
+        else if constexpr (Op == lane_op::div) { return _mm_div_pd(a, b); }
+        else {
+            __m128d mask;
+
+            if constexpr (Op == lane_op::eq) { mask = _mm_cmpeq_pd(a, b); }
+            else if constexpr (Op == lane_op::ne) { mask = _mm_cmpneq_pd(a, b); }
+            else if constexpr (Op == lane_op::lt) { mask = _mm_cmplt_pd(a, b); }
+            else if constexpr (Op == lane_op::le) { mask = _mm_cmple_pd(a, b); }
+            else if constexpr (Op == lane_op::gt) { mask = _mm_cmpgt_pd(a, b); }
+            else                                  { mask = _mm_cmpge_pd(a, b); }
+
+            return _mm_and_pd(mask, _mm_set1_pd(1.0));
+        }
+    }
+
+#endif
+
+    template<lane_op Op>
+    void lane_loop(const double* a, const double* b, double* out, std::size_t n) {
+
+        std::size_t i = 0;
+
+#if defined(OLIVER_SIMD_AVX)
+        for (; i + 4 <= n; i += 4) {
+            _mm256_storeu_pd(out + i, vector_lane<Op>(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        }
+#elif defined(OLIVER_SIMD_SSE2)
+        for (; i + 2 <= n; i += 2) {
+            _mm_storeu_pd(out + i, vector_lane<Op>(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        }
+#endif
+
+        for (; i < n; ++i) {
+            out[i] = scalar_lane<Op>(a[i], b[i]);
+        }
+    }
+
+    /********************************************************************************************/
+    //
+    //                              SIMD Elementary Functions
+    //
+    //        Batch versions of exp, log, the trigonometric and the hyperbolic
+    //        functions.  Each is written once, against a set of lane primitives,
+    //        and instantiated for the AVX, SSE2 or scalar lanes.  So the vector
+    //        lanes and the scalar remainder compute the same result.
+    //
+    //        Arguments are reduced by Cody-Waite, (ln 2 for exp and log, pi / 2 for
+    //        the trigonometric functions), and the reduced argument is evaluated by
+    //        polynomial.  The coefficients of log, sin and cos are those of fdlibm.
+    //        Against the C library, exp and log differ by at most one ulp, sin, cos,
+    //        sinh and cosh by two, and tan and tanh by four.
+    //
+    //        Trigonometric arguments beyond 'trig_limit' need a wider reduction,
+    //        so those elements are recomputed by the C library.  Infinities, NaN,
+    //        zeros, and the arguments of log outside of its domain, give the same
+    //        special values as the C library.
+    //
+    /********************************************************************************************/
+
+    enum class lane_fn : std::uint8_t { exp, log, sin, cos, tan, sinh, cosh, tanh };
+
+    struct scalar_lanes {
+        using reg  = double;
+        using mask = bool;
+
+        static constexpr std::size_t width = 1;
+
+        static reg     load(const double* p)        { return *p; }
+        static void   store(double* p, reg x)       { *p = x; }
+        static reg      set(double x)               { return x; }
+
+        static reg      add(reg a, reg b)           { return a + b; }
+        static reg      sub(reg a, reg b)           { return a - b; }
+        static reg      mul(reg a, reg b)           { return a * b; }
+        static reg      div(reg a, reg b)           { return a / b; }
+        static reg      min(reg a, reg b)           { return a < b ? a : b; }  // As 'minpd', 'b' if either is NaN.
+        static reg      max(reg a, reg b)           { return a > b ? a : b; }
+        static reg      abs(reg x)                  { return std::fabs(x); }
+        static reg    round(reg x)                  { return std::nearbyint(x); }
+
+        static mask      lt(reg a, reg b)           { return a < b; }
+        static mask      eq(reg a, reg b)           { return a == b; }
+        static mask  is_nan(reg x)                  { return x != x; }
+        static reg   select(mask m, reg a, reg b)   { return m ? a : b; }
+
+        // 2^n, for an integral 'n' within the normal exponents.
+        static reg     pow2(reg n) {
+            return std::bit_cast<double>(static_cast<std::uint64_t>(static_cast<std::int64_t>(n) + 1023) << 52);
+        }
+
+        // The unbiased exponent and the significand in [1, 2), of a positive normal 'x'.
+        static reg exponent(reg x) {
+            return static_cast<double>(static_cast<std::int64_t>(std::bit_cast<std::uint64_t>(x) >> 52) - 1023);
+        }
+
+        static reg mantissa(reg x) {
+            return std::bit_cast<double>((std::bit_cast<std::uint64_t>(x) & 0x000FFFFFFFFFFFFFull) | 0x3FF0000000000000ull);
+        }
+    };
+
+#if defined(OLIVER_SIMD_AVX)
+
+    struct vector_lanes {
+        using reg  = __m256d;
+        using mask = __m256d;
+
+        static constexpr std::size_t width = 4;
+
+        static reg     load(const double* p)        { return _mm256_loadu_pd(p); }
+        static void   store(double* p, reg x)       { _mm256_storeu_pd(p, x); }
+        static reg      set(double x)               { return _mm256_set1_pd(x); }
+
+        static reg      add(reg a, reg b)           { return _mm256_add_pd(a, b); }
+        static reg      sub(reg a, reg b)           { return _mm256_sub_pd(a, b); }
+        static reg      mul(reg a, reg b)           { return _mm256_mul_pd(a, b); }
+        static reg      div(reg a, reg b)           { return _mm256_div_pd(a, b); }
+        static reg      min(reg a, reg b)           { return _mm256_min_pd(a, b); }
+        static reg      max(reg a, reg b)           { return _mm256_max_pd(a, b); }
+        static reg      abs(reg x)                  { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), x); }
+        static reg    round(reg x)                  { return _mm256_round_pd(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+        static mask      lt(reg a, reg b)           { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+        static mask      eq(reg a, reg b)           { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+        static mask  is_nan(reg x)                  { return _mm256_cmp_pd(x, x, _CMP_UNORD_Q); }
+        static reg   select(mask m, reg a, reg b)   { return _mm256_blendv_pd(b, a, m); }
+
+        // AVX has no 256 bit integer operations, so the exponent bits are built in 128 bit halves.
+        static reg     pow2(reg n) {
+            const __m128i e = _mm_slli_epi32(_mm_add_epi32(_mm256_cvtpd_epi32(n), _mm_set1_epi32(1023)), 20);
+
+            const __m128i lo = _mm_unpacklo_epi32(_mm_setzero_si128(), e);
+            const __m128i hi = _mm_unpackhi_epi32(_mm_setzero_si128(), e);
+
+            return _mm256_castsi256_pd(_mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1));
+        }
+
+        static reg exponent(reg x) {
+            const __m256i bits = _mm256_castpd_si256(x);
+
+            const __m128i lo = _mm_srli_epi64(_mm256_castsi256_si128(bits), 52);
+            const __m128i hi = _mm_srli_epi64(_mm256_extractf128_si256(bits, 1), 52);
+
+            // The biased exponent is placed in the significand of 2^52, to convert it exactly.
+            const reg biased = _mm256_or_pd(_mm256_castsi256_pd(_mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1)), set(0x1p52));
+
+            return _mm256_sub_pd(biased, set(0x1p52 + 1023));
+        }
+
+        static reg mantissa(reg x) {
+            const reg significand = _mm256_castsi256_pd(_mm256_set1_epi64x(0x000FFFFFFFFFFFFFll));
+
+            return _mm256_or_pd(_mm256_and_pd(x, significand), set(1.0));
+        }
+    };
+
+#elif defined(OLIVER_SIMD_SSE2)
+
+    struct vector_lanes {
+        using reg  = __m128d;
+        using mask = __m128d;
+
+        static constexpr std::size_t width = 2;
+
+        static reg     load(const double* p)        { return _mm_loadu_pd(p); }
+        static void   store(double* p, reg x)       { _mm_storeu_pd(p, x); }
+        static reg      set(double x)               { return _mm_set1_pd(x); }
+
+        static reg      add(reg a, reg b)           { return _mm_add_pd(a, b); }
+        static reg      sub(reg a, reg b)           { return _mm_sub_pd(a, b); }
+        static reg      mul(reg a, reg b)           { return _mm_mul_pd(a, b); }
+        static reg      div(reg a, reg b)           { return _mm_div_pd(a, b); }
+        static reg      min(reg a, reg b)           { return _mm_min_pd(a, b); }
+        static reg      max(reg a, reg b)           { return _mm_max_pd(a, b); }
+        static reg      abs(reg x)                  { return _mm_andnot_pd(_mm_set1_pd(-0.0), x); }
+
+        // SSE2 has no rounding instruction.  Adding and subtracting 1.5 * 2^52
+        // rounds to the nearest even integer, for any argument the kernels round.
+        static reg    round(reg x)                  { return _mm_sub_pd(_mm_add_pd(x, set(0x1.8p52)), set(0x1.8p52)); }
+
+        static mask      lt(reg a, reg b)           { return _mm_cmplt_pd(a, b); }
+        static mask      eq(reg a, reg b)           { return _mm_cmpeq_pd(a, b); }
+        static mask  is_nan(reg x)                  { return _mm_cmpunord_pd(x, x); }
+        static reg   select(mask m, reg a, reg b)   { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+
+        static reg     pow2(reg n) {
+            const __m128i e = _mm_slli_epi32(_mm_add_epi32(_mm_cvtpd_epi32(n), _mm_set1_epi32(1023)), 20);
+
+            return _mm_castsi128_pd(_mm_unpacklo_epi32(_mm_setzero_si128(), e));
+        }
+
+        static reg exponent(reg x) {
+            const reg biased = _mm_or_pd(_mm_castsi128_pd(_mm_srli_epi64(_mm_castpd_si128(x), 52)), set(0x1p52));
+
+            return _mm_sub_pd(biased, set(0x1p52 + 1023));
+        }
+
+        static reg mantissa(reg x) {
+            const reg significand = _mm_castsi128_pd(_mm_set1_epi64x(0x000FFFFFFFFFFFFFll));
+
+            return _mm_or_pd(_mm_and_pd(x, significand), set(1.0));
+        }
+    };
+
+#endif
+
+    inline constexpr double trig_limit = 0x1p19;
+
+    // Horner's rule, from the highest coefficient.
+    template<typename V, std::size_t N>
+    typename V::reg polynomial(typename V::reg x, const double (&c)[N]) {
+
+        typename V::reg p = V::set(c[0]);
+
+        for (std::size_t i = 1; i < N; ++i) {
+            p = V::add(V::mul(p, x), V::set(c[i]));
+        }
+
+        return p;
+    }
+
+    // e^x * 2^k, for an integral 'k'.  Scaling the result by 2^k is exact.
+    template<typename V>
+    typename V::reg exp_lane(typename V::reg x, double k = 0) {
+
+        constexpr double ln2_hi = 6.93147180369123816490e-01;
+        constexpr double ln2_lo = 1.90821492927058770002e-10;
+
+        // 1 / 13! ... 1 / 0!, |r| is no more than ln 2 / 2.
+        constexpr double taylor[] = {
+            1.0 / 6227020800.0, 1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0, 1.0 / 362880.0,
+            1.0 / 40320.0, 1.0 / 5040.0, 1.0 / 720.0, 1.0 / 120.0, 1.0 / 24.0, 1.0 / 6.0, 0.5, 1.0, 1.0
+        };
+
+        const auto y = V::max(V::min(x, V::set(711.0)), V::set(-746.0));
+        const auto n = V::round(V::mul(y, V::set(1.44269504088896340736)));
+        const auto r = V::sub(V::sub(y, V::mul(n, V::set(ln2_hi))), V::mul(n, V::set(ln2_lo)));
+
+        // Scaled in two steps, so that a subnormal result is rounded only once.
+        const auto n1 = V::round(V::mul(n, V::set(0.5)));
+        const auto n2 = V::add(V::sub(n, n1), V::set(k));
+
+        const auto result = V::mul(V::mul(polynomial<V>(r, taylor), V::pow2(n1)), V::pow2(n2));
+
+        return V::select(V::is_nan(x), x, result);
+    }
+
+    template<typename V>
+    typename V::reg log_lane(typename V::reg x) {
+
+        constexpr double ln2_hi = 6.93147180369123816490e-01;
+        constexpr double ln2_lo = 1.90821492927058770002e-10;
+
+        constexpr double lg[] = {
+            1.479819860511658591e-01, 1.531383769920937332e-01, 1.818357216161805012e-01, 2.222219843214978396e-01,
+            2.857142874366239149e-01, 3.999999999940941908e-01, 6.666666666666735130e-01, 0.0
+        };
+
+        // Subnormals are scaled into the normal range.
+        const auto tiny = V::lt(x, V::set(std::numeric_limits<double>::min()));
+        const auto y    = V::select(tiny, V::mul(x, V::set(0x1p54)), x);
+
+        auto e = V::sub(V::exponent(y), V::select(tiny, V::set(54.0), V::set(0.0)));
+        auto m = V::mantissa(y);
+
+        // Center the significand on one, in [sqrt(2) / 2, sqrt(2)).
+        const auto high = V::lt(V::set(1.41421356237309504880), m);
+
+        m = V::select(high, V::mul(m, V::set(0.5)), m);
+        e = V::select(high, V::add(e, V::set(1.0)), e);
+
+        const auto f    = V::sub(m, V::set(1.0));
+        const auto s    = V::div(f, V::add(f, V::set(2.0)));
+        const auto R    = polynomial<V>(V::mul(s, s), lg);
+        const auto hfsq = V::mul(V::set(0.5), V::mul(f, f));
+
+        auto result = V::sub(V::mul(e, V::set(ln2_hi)),
+                             V::sub(V::sub(hfsq, V::add(V::mul(s, V::add(hfsq, R)), V::mul(e, V::set(ln2_lo)))), f));
+
+        result = V::select(V::lt(x, V::set(0.0)), V::set(std::numeric_limits<double>::quiet_NaN()), result);
+        result = V::select(V::eq(x, V::set(0.0)), V::set(-std::numeric_limits<double>::infinity()), result);
+        result = V::select(V::eq(x, V::set(std::numeric_limits<double>::infinity())), x, result);
+
+        return V::select(V::is_nan(x), x, result);
+    }
+
+    /*
+        Reduces 'x' to 'r' in [-pi / 4, pi / 4] and its quadrant 'k', with
+        'x = r + (q * pi / 2)' and 'k = q mod 4'.  Then computes sin(r) and cos(r).
+    */
+    template<typename V>
+    void sin_cos_lane(typename V::reg x, typename V::reg& k, typename V::reg& s, typename V::reg& c) {
+
+        constexpr double pio2_1  = 1.57079632673412561417e+00;
+        constexpr double pio2_2  = 6.07710050630396597660e-11;
+        constexpr double pio2_2t = 2.02226624879595063154e-21;
+
+        constexpr double sine[] = {
+            1.58969099521155010221e-10, -2.50507602534068634195e-08, 2.75573137070700676789e-06,
+           -1.98412698298579493134e-04,  8.33333333332248946124e-03, -1.66666666666666324348e-01
+        };
+
+        constexpr double cosine[] = {
+           -1.13596475577881948265e-11,  2.08757232129817482790e-09, -2.75573143513906633035e-07,
+            2.48015872894767294178e-05, -1.38888888888741095749e-03,  4.16666666666666019037e-02
+        };
+
+        const auto q = V::round(V::mul(x, V::set(6.36619772367581382433e-01)));
+        const auto r = V::sub(V::sub(V::sub(x, V::mul(q, V::set(pio2_1))), V::mul(q, V::set(pio2_2))), V::mul(q, V::set(pio2_2t)));
+
+        const auto z = V::mul(r, r);
+
+        s = V::add(r, V::mul(V::mul(r, z), polynomial<V>(z, sine)));
+        c = V::add(V::sub(V::set(1.0), V::mul(V::set(0.5), z)), V::mul(V::mul(z, z), polynomial<V>(z, cosine)));
+
+        // 'q - 4 * floor(q / 4)'.
+        auto d = V::round(V::mul(q, V::set(0.25)));
+
+        d = V::select(V::lt(V::mul(q, V::set(0.25)), d), V::sub(d, V::set(1.0)), d);
+        k = V::sub(q, V::mul(d, V::set(4.0)));
+    }
+
+    template<typename V>
+    typename V::reg sinh_series(typename V::reg x) {
+
+        // 1 / 19!, ... 1 / 3!, for |x| less than one.
+        constexpr double taylor[] = {
+            1.0 / 121645100408832000.0, 1.0 / 355687428096000.0, 1.0 / 1307674368000.0, 1.0 / 6227020800.0,
+            1.0 / 39916800.0, 1.0 / 362880.0, 1.0 / 5040.0, 1.0 / 120.0, 1.0 / 6.0
+        };
+
+        const auto z = V::mul(x, x);
+
+        return V::add(x, V::mul(V::mul(x, z), polynomial<V>(z, taylor)));
+    }
+
+    template<lane_fn Fn, typename V>
+    typename V::reg function_lane(typename V::reg x) {
+
+        if constexpr (Fn == lane_fn::exp) {
+            return exp_lane<V>(x);
+        }
+        else if constexpr (Fn == lane_fn::log) {
+            return log_lane<V>(x);
+        }
+        else if constexpr (Fn == lane_fn::sin || Fn == lane_fn::cos || Fn == lane_fn::tan) {
+
+            typename V::reg k, s, c;
+
+            sin_cos_lane<V>(x, k, s, c);
+
+            // The cosine is the sine of the next quadrant.
+            if constexpr (Fn == lane_fn::cos) {
+                k = V::select(V::eq(k, V::set(3.0)), V::set(0.0), V::add(k, V::set(1.0)));
+            }
+
+            const auto odd = V::eq(V::abs(V::sub(k, V::set(2.0))), V::set(1.0));  // Quadrant one or three.
+
+            typename V::reg y;
+
+            if constexpr (Fn == lane_fn::tan) {  // s / c, -c / s.
+                y = V::select(odd, V::div(V::sub(V::set(-0.0), c), s), V::div(s, c));
+            }
+            else {  // s, c, -s, -c.
+                y = V::select(odd, c, s);
+                y = V::select(V::lt(V::set(1.5), k), V::sub(V::set(-0.0), y), y);
+            }
+
+            if constexpr (Fn == lane_fn::cos) {
+                return y;
+            }
+            else {  // The sign of a zero is kept.
+                return V::select(V::eq(x, V::set(0.0)), x, y);
+            }
+        }
+        else {
+            const auto ax = V::abs(x);
+            const auto h  = exp_lane<V>(ax, -1);  // e^|x| / 2.
+
+            if constexpr (Fn == lane_fn::cosh) {
+                return V::add(h, V::div(V::set(0.25), h));
+            }
+            else if constexpr (Fn == lane_fn::sinh) {
+                const auto y = V::sub(h, V::div(V::set(0.25), h));
+                return V::select(V::lt(ax, V::set(1.0)), sinh_series<V>(x), V::select(V::lt(x, V::set(0.0)), V::sub(V::set(-0.0), y), y));
+            }
+            else {
+                // 1 - 2 / (e^(2|x|) + 1), with e^(2|x|) = 4 * h^2.
+                const auto small = V::div(sinh_series<V>(x), V::add(h, V::div(V::set(0.25), h)));
+                const auto y     = V::sub(V::set(1.0), V::div(V::set(2.0), V::add(V::mul(V::set(4.0), V::mul(h, h)), V::set(1.0))));
+
+                return V::select(V::lt(ax, V::set(1.0)), small, V::select(V::lt(x, V::set(0.0)), V::sub(V::set(-0.0), y), y));
+            }
+        }
+    }
+
+    template<lane_fn Fn>
+    void function_loop(const double* a, double* out, std::size_t n) {
+
+        std::size_t i = 0;
+
+#if defined(OLIVER_SIMD_AVX) || defined(OLIVER_SIMD_SSE2)
+        for (; i + vector_lanes::width <= n; i += vector_lanes::width) {
+            vector_lanes::store(out + i, function_lane<Fn, vector_lanes>(vector_lanes::load(a + i)));
+        }
+#endif
+
+        for (; i < n; ++i) {
+            out[i] = function_lane<Fn, scalar_lanes>(a[i]);
+        }
+
+        if constexpr (Fn == lane_fn::sin || Fn == lane_fn::cos || Fn == lane_fn::tan) {
+
+            for (i = 0; i < n; ++i) {
+
+                if (std::fabs(a[i]) > trig_limit) {
+                    out[i] = Fn == lane_fn::sin ? std::sin(a[i]) : Fn == lane_fn::cos ? std::cos(a[i]) : std::tan(a[i]);
+                }
+            }
+        }
+    }
+
+    inline void simd_apply(lane_op op, const double* a, const double* b, double* out, std::size_t n) {
+
+        switch (op) {
+
+        case lane_op::add: return lane_loop<lane_op::add>(a, b, out, n);
+        case lane_op::sub: return lane_loop<lane_op::sub>(a, b, out, n);
+        case lane_op::mul: return lane_loop<lane_op::mul>(a, b, out, n);
+        case lane_op::div: return lane_loop<lane_op::div>(a, b, out, n);
+        case lane_op::eq:  return lane_loop<lane_op::eq>(a, b, out, n);
+        case lane_op::ne:  return lane_loop<lane_op::ne>(a, b, out, n);
+        case lane_op::lt:  return lane_loop<lane_op::lt>(a, b, out, n);
+        case lane_op::le:  return lane_loop<lane_op::le>(a, b, out, n);
+        case lane_op::gt:  return lane_loop<lane_op::gt>(a, b, out, n);
+        case lane_op::ge:  return lane_loop<lane_op::ge>(a, b, out, n);
+        }
+    }
+
+    inline bool simd_apply(lane_op op, const std::int64_t* a, const std::int64_t* b, std::int64_t* out, std::size_t n) {
+
+        switch (op) {
+
+        case lane_op::add:
+            for (std::size_t i = 0; i < n; ++i) { out[i] = a[i] + b[i]; }
+            return true;
+
+        case lane_op::sub:
+            for (std::size_t i = 0; i < n; ++i) { out[i] = a[i] - b[i]; }
+            return true;
+
+        case lane_op::mul:
+            for (std::size_t i = 0; i < n; ++i) { out[i] = a[i] * b[i]; }
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    inline void simd_apply(lane_fn fn, const double* a, double* out, std::size_t n) {
+
+        switch (fn) {
+
+        case lane_fn::exp:  return function_loop<lane_fn::exp>(a, out, n);
+        case lane_fn::log:  return function_loop<lane_fn::log>(a, out, n);
+        case lane_fn::sin:  return function_loop<lane_fn::sin>(a, out, n);
+        case lane_fn::cos:  return function_loop<lane_fn::cos>(a, out, n);
+        case lane_fn::tan:  return function_loop<lane_fn::tan>(a, out, n);
+        case lane_fn::sinh: return function_loop<lane_fn::sinh>(a, out, n);
+        case lane_fn::cosh: return function_loop<lane_fn::cosh>(a, out, n);
+        case lane_fn::tanh: return function_loop<lane_fn::tanh>(a, out, n);
+        }
+    }
+}
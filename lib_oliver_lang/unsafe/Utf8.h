@@ -0,0 +1,218 @@
+#pragma once
+
+/*****************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//        This program is free software : you can redistribute it and /or modify
+//        it under the terms of the GNU Affero General Public License as published by
+//        the Free Software Foundation, either version 3 of the License, or
+//        (at your option) any later version.
+//
+//        This program is distributed in the hope that it will be useful,
+//        but WITHOUT ANY WARRANTY; without even the implied warranty of
+//        MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//        GNU Affero General Public License for more details.
+//
+//        You should have received a copy of the GNU Affero General Public License
+//        along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//        The author can be reached at: maxjmartin@gmail.com
+//
+/*****************************************************************************************/
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define OLIVER_UTF8_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OLIVER_UTF8_SSE2
+#endif
+
+namespace Oliver {
+
+    /********************************************************************************************/
+    //
+    //                                  UTF-8 Byte Kernels
+    //
+    //        Counting and validation over a contiguous buffer of UTF-8.  A block of
+    //        thirty two bytes is examined at a time with AVX2, sixteen with SSE2.
+    //
+    //        A code point is counted at each byte which is not a continuation byte,
+    //        '10xxxxxx', so the count is exact for valid UTF-8.  Validation skips
+    //        whole blocks of ASCII, and checks each multibyte sequence against the
+    //        well formed byte ranges of the Unicode Standard, (table 3-7), which
+    //        excludes overlong forms, surrogates, and code points above U+10FFFF.
+    //
+    /********************************************************************************************/
+
+#if defined(OLIVER_UTF8_AVX2)
+    constexpr std::size_t utf8_block = 32;
+#elif defined(OLIVER_UTF8_SSE2)
+    constexpr std::size_t utf8_block = 16;
+#else
+    constexpr std::size_t utf8_block = 8;
+#endif
+
+    constexpr bool utf8_is_continuation(char c) noexcept {
+        return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+    }
+
+    // The length of the sequence led by 'c', which must not be a continuation byte.
+    constexpr std::size_t utf8_sequence_length(char c) noexcept {
+
+        const auto b = static_cast<unsigned char>(c);
+
+        return b < 0x80 ? 1 : b < 0xE0 ? 2 : b < 0xF0 ? 3 : 4;
+    }
+
+    // The number of bytes in a block of 'utf8_block', which lead a code point.
+    inline std::size_t utf8_block_count(const char* s) noexcept {
+
+#if defined(OLIVER_UTF8_AVX2)
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+        const auto    m = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(-65))));
+        return std::popcount(m);
+#elif defined(OLIVER_UTF8_SSE2)
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+        const auto    m = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(v, _mm_set1_epi8(-65))));
+        return std::popcount(m);
+#else
+        std::size_t n = 0;
+
+        for (std::size_t i = 0; i < utf8_block; ++i) {
+            n += !utf8_is_continuation(s[i]);
+        }
+
+        return n;
+#endif
+    }
+
+    // Is a block of 'utf8_block' bytes entirely ASCII?
+    inline bool utf8_block_is_ascii(const char* s) noexcept {
+
+#if defined(OLIVER_UTF8_AVX2)
+        return !_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)));
+#elif defined(OLIVER_UTF8_SSE2)
+        return !_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+#else
+        unsigned char bits = 0;
+
+        for (std::size_t i = 0; i < utf8_block; ++i) {
+            bits |= static_cast<unsigned char>(s[i]);
+        }
+
+        return bits < 0x80;
+#endif
+    }
+
+    // The number of code points in 'n' bytes of valid UTF-8.
+    inline std::size_t utf8_count(const char* s, std::size_t n) noexcept {
+
+        std::size_t count = 0;
+        std::size_t i     = 0;
+
+        for (; i + utf8_block <= n; i += utf8_block) {
+            count += utf8_block_count(s + i);
+        }
+
+        for (; i < n; ++i) {
+            count += !utf8_is_continuation(s[i]);
+        }
+
+        return count;
+    }
+
+    // The length of a well formed sequence at the start of 's', or zero if there is none.
+    inline std::size_t utf8_sequence(const unsigned char* s, std::size_t n) noexcept {
+
+        const unsigned char b = s[0];
+
+        if (b < 0x80) {
+            return 1;
+        }
+
+        auto in = [&](std::size_t i, unsigned char lo, unsigned char hi) {
+            return i < n && s[i] >= lo && s[i] <= hi;
+        };
+
+        if (b >= 0xC2 && b <= 0xDF) {
+            return in(1, 0x80, 0xBF) ? 2 : 0;
+        }
+
+        if (b >= 0xE0 && b <= 0xEF) {
+            const unsigned char lo = b == 0xE0 ? 0xA0 : 0x80;
+            const unsigned char hi = b == 0xED ? 0x9F : 0xBF;
+
+            return in(1, lo, hi) && in(2, 0x80, 0xBF) ? 3 : 0;
+        }
+
+        if (b >= 0xF0 && b <= 0xF4) {
+            const unsigned char lo = b == 0xF0 ? 0x90 : 0x80;
+            const unsigned char hi = b == 0xF4 ? 0x8F : 0xBF;
+
+            return in(1, lo, hi) && in(2, 0x80, 0xBF) && in(3, 0x80, 0xBF) ? 4 : 0;
+        }
+
+        return 0;
+    }
+
+    // The length of the longest valid prefix of 's', so 's.size()' if it is all valid.
+    inline std::size_t utf8_valid_prefix(std::string_view s) noexcept {
+
+        const auto*       p = reinterpret_cast<const unsigned char*>(s.data());
+        const std::size_t n = s.size();
+
+        std::size_t i = 0;
+
+        while (i < n) {
+
+            if (i + utf8_block <= n && utf8_block_is_ascii(s.data() + i)) {
+                i += utf8_block;
+                continue;
+            }
+
+            const std::size_t k = utf8_sequence(p + i, n - i);
+
+            if (!k) {
+                return i;
+            }
+
+            i += k;
+        }
+
+        return n;
+    }
+
+    // A copy of 's' with each byte which does not begin a valid sequence replaced by U+FFFD.
+    inline std::string utf8_repair(std::string_view s) {
+
+        std::string result;
+
+        result.reserve(s.size() + 8);
+
+        while (!s.empty()) {
+
+            const std::size_t k = utf8_valid_prefix(s);
+
+            result.append(s.substr(0, k));
+            s.remove_prefix(k);
+
+            if (!s.empty()) {
+                result.append("\xEF\xBF\xBD");
+                s.remove_prefix(1);
+            }
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,185 @@
+/********************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//          This program is free software : you can redistribute it and /or modify
+//          it under the terms of the GNU Affero General Public License as published by
+//          the Free Software Foundation, either version 3 of the License, or
+//          (at your option) any later version.
+//
+//          This program is distributed in the hope that it will be useful,
+//          but WITHOUT ANY WARRANTY; without even the implied warranty of
+//          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//          GNU Affero General Public License for more details.
+//
+//          You should have received a copy of the GNU Affero General Public License
+//          along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//          The author can be reached at: maxjmartin@gmail.com
+//
+/********************************************************************************************/
+
+#include <complex>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "oliver_lang.h"
+
+/*
+    Counts every call of the global 'operator new', aligned or not, so that a
+    sequence of moves can be checked to make no heap allocation.
+*/
+static std::size_t allocations = 0;
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"  // The replacements below do match.
+#endif
+
+void* operator new(std::size_t size) {
+
+    ++allocations;
+
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {  // As used by the default memory resource.
+
+    ++allocations;
+
+    const auto a = static_cast<std::size_t>(align);
+
+#if defined(_MSC_VER)
+    if (void* p = _aligned_malloc(size ? size : 1, a)) {
+        return p;
+    }
+#else
+    if (void* p = std::aligned_alloc(a, size ? (size + a - 1) / a * a : a)) {
+        return p;
+    }
+#endif
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+#if defined(_MSC_VER)
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t align) noexcept {
+    operator delete(p, align);
+}
+
+static int failures = 0;
+
+static void check_no_allocations(const char* name, std::size_t before) {
+
+    const std::size_t n = allocations - before;
+
+    if (n) {
+        fmt::println("FAILED: {} made {} allocations", name, n);
+        ++failures;
+    }
+}
+
+int main() {
+
+    using namespace Oliver;
+
+    var l{ list() };
+
+    for (long long i = 0; i < 64; ++i) {
+        l = l.push(var(number(i)));
+    }
+
+    {
+        const std::size_t before = allocations;
+
+        var a = std::move(l);
+        var b;
+
+        for (int i = 0; i < 1000; ++i) {
+            b = std::move(a);
+            a = std::move(b);
+
+            var c(std::move(a));
+            a = std::move(c);
+        }
+
+        l = std::move(a);
+
+        check_no_allocations("moving a list between vars", before);
+    }
+
+    {
+        for (int i = 0; i < 64; ++i) {  // Empty the list, which keeps its capacity.
+            l = l.drop();
+        }
+
+        const std::size_t before = allocations;
+
+        for (long long i = 0; i < 64; ++i) {
+            l = l.push(var(number(i)));
+        }
+
+        check_no_allocations("a chain of list pushes", before);
+    }
+
+    {
+        const std::size_t before = allocations;
+
+        var x{ number(0ll) };
+
+        for (long long i = 0; i < 1000; ++i) {
+            x = x + var(number(i));
+        }
+
+        check_no_allocations("a chain of number additions", before);
+    }
+
+    {
+        std::vector<var> reals;
+        reals.reserve(4096);
+
+        const std::size_t before = allocations;
+
+        for (int i = 0; i < 4096; ++i) {  // Numbers are held in place, with or without copy on write.
+            reals.emplace_back(number(std::complex<double>(i + 0.5, 0.0)));
+        }
+
+        check_no_allocations("constructing distinct real numbers", before);
+    }
+
+    {
+        var t{ text("warm") };  // The first text fills the payload pool.
+
+        const std::size_t before = allocations;
+
+        for (int i = 0; i < 1000; ++i) {  // Held in the rope's small string, rather than a tree.
+            var s{ text("abc") };
+            var a = s.lead();
+            var b = s.drop();
+        }
+
+        check_no_allocations("constructing and slicing short texts", before);
+    }
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+/********************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//          This program is free software : you can redistribute it and /or modify
+//          it under the terms of the GNU Affero General Public License as published by
+//          the Free Software Foundation, either version 3 of the License, or
+//          (at your option) any later version.
+//
+//          This program is distributed in the hope that it will be useful,
+//          but WITHOUT ANY WARRANTY; without even the implied warranty of
+//          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//          GNU Affero General Public License for more details.
+//
+//          You should have received a copy of the GNU Affero General Public License
+//          along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//          The author can be reached at: maxjmartin@gmail.com
+//
+/********************************************************************************************/
+
+#include <cstdlib>
+#include <string>
+
+#include "oliver_lang.h"
+
+static int failures = 0;
+
+static void check(const char* name, bool passed) {
+
+    if (!passed) {
+        fmt::println("FAILED: {}", name);
+        ++failures;
+    }
+}
+
+static Oliver::var parse(const char* str) {
+    return Oliver::var(Oliver::number(std::string(str)));
+}
+
+static std::string text_of(const Oliver::var& x) {
+    return fmt::format("{}", x);
+}
+
+int main() {
+
+    using namespace Oliver;
+
+    // Rationals whose cross products overflow an int64 are compared as big rationals.
+    check("1/3 < (2^63 - 1)/2", parse("1/3") < parse("9223372036854775807/2"));
+    check("(2^63 - 1)/2 > 1/3", parse("9223372036854775807/2") > parse("1/3"));
+
+    // Rationals whose quotient overflows an int64 are divided as big rationals.
+    check("(2^63 - 1)/2 / 1/3", text_of(parse("9223372036854775807/2") / parse("1/3")) == "27670116110564327421/2");
+
+    // A divisor of -2^63 has no int64 reciprocal.
+    check("1/3 / -2^63", text_of(parse("1/3") / parse("-9223372036854775808/1")) == "-1/27670116110564327424");
+    check("-2^63/1 compares", parse("-9223372036854775808/1") < parse("1/3"));
+
+    // Decimals still compare and divide exactly.
+    check("1.5d < 2.25d", parse("1.5d") < parse("2.25d"));
+    check("2.25d > 1.5d", parse("2.25d") > parse("1.5d"));
+    check("1.5d / 0.25d", text_of(parse("1.5d") / parse("0.25d")) == "6d");
+    check("1.5d / 4d",    text_of(parse("1.5d") / parse("4d")) == "0.375d");
+
+    // Zero raised to a negative power has no exact result, it is that of a real.
+    check("0.0d ^ -1", text_of(parse("0.0d").pow(parse("-1"))) == text_of(parse("0.0").pow(parse("-1"))));
+    check("0.00d ^ -2", text_of(parse("0.00d").pow(parse("-2"))) == text_of(parse("0.0").pow(parse("-2"))));
+
+    // Powers too large to hold exactly are real, while 0, 1 and -1 stay exact for any exponent.
+    check("2 ^ 4000000000",   text_of(parse("2").pow(parse("4000000000"))) == text_of(parse("2.0").pow(parse("4000000000"))));
+    check("3/2 ^ -4000000000", text_of(parse("3/2").pow(parse("-4000000000"))) == text_of(parse("1.5").pow(parse("-4000000000"))));
+    check("-1 ^ 4000000001",  text_of(parse("-1").pow(parse("4000000001"))) == "-1");
+    check("0 ^ 4000000000",   text_of(parse("0").pow(parse("4000000000"))) == "0");
+    check("2 ^ 100",          text_of(parse("2").pow(parse("100"))) == "1267650600228229401496703205376");
+
+    // A list of exact numbers paired with itself, which is not run by the SIMD kernels.
+    var exact{ list() };
+    exact = exact.push(parse("1/3"));
+    exact = exact.push(parse("2.5d"));
+
+    check("x.elementwise(+, x)", text_of(exact.elementwise(op_code::ADD_op, exact)) == "[5.0d, 2/3]");
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
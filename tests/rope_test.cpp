@@ -0,0 +1,167 @@
+/********************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//          This program is free software : you can redistribute it and /or modify
+//          it under the terms of the GNU Affero General Public License as published by
+//          the Free Software Foundation, either version 3 of the License, or
+//          (at your option) any later version.
+//
+//          This program is distributed in the hope that it will be useful,
+//          but WITHOUT ANY WARRANTY; without even the implied warranty of
+//          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//          GNU Affero General Public License for more details.
+//
+//          You should have received a copy of the GNU Affero General Public License
+//          along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//          The author can be reached at: maxjmartin@gmail.com
+//
+/********************************************************************************************/
+
+#include <cstdlib>
+#include <memory_resource>
+#include <random>
+#include <string>
+
+#include "oliver_lang.h"
+
+/*
+    Applies a random sequence of appends, prepends and substrings to a rope,
+    and the same to a 'std::string', checking that the two agree after each.
+    Pieces range from a few characters to several chunks, so the rope moves
+    between its small string and a tree, and the tree is joined and split at
+    every height.
+*/
+static int failures = 0;
+
+static bool check(const char* name, bool passed) {
+
+    if (!passed) {
+        fmt::println("FAILED: {}", name);
+        ++failures;
+    }
+    return passed;
+}
+
+static int sign(int x) {
+    return (x > 0) - (x < 0);
+}
+
+static bool agrees(const Oliver::rope& r, const std::string& s, std::mt19937& gen) {
+
+    bool passed = check("size", r.size() == s.size())
+               && check("str", r.str() == s)
+               && check("iterate", std::string(r.begin(), r.end()) == s)
+               && check("balanced", r.balanced());
+
+    for (int i = 0; passed && i < 8 && !s.empty(); ++i) {
+        const std::size_t k = gen() % s.size();
+        passed = check("at", r.at(k) == s[k]);
+    }
+
+    return passed;
+}
+
+int main() {
+
+    using namespace Oliver;
+
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource();
+
+    std::mt19937 gen(2024);
+
+    const auto piece = [&] {
+        const std::size_t n = gen() % 4 == 0 ? gen() % (3 * rope::chunk_size) : gen() % 16;
+        std::string s(n, '\0');
+        for (char& c : s) {
+            c = static_cast<char>('a' + gen() % 26);
+        }
+        return s;
+    };
+
+    for (int round = 0; round < 100 && !failures; ++round) {
+
+        rope        r(resource);
+        std::string s;
+
+        for (int step = 0; step < 200 && !failures; ++step) {
+
+            const std::string p = piece();
+
+            switch (gen() % 5) {
+
+            case 0:
+            case 1:
+                r.append(rope(p, resource));
+                s += p;
+                break;
+
+            case 2:
+                r.prepend(rope(p, resource));
+                s.insert(0, p);
+                break;
+
+            case 3: {
+                const std::size_t pos = gen() % (s.size() + 1);
+                const std::size_t n   = gen() % (s.size() + 1);
+
+                rope t = r.substr(pos, n);
+
+                if (!check("substr", t.str() == s.substr(pos, n)) || !check("substr balanced", t.balanced())) {
+                    break;
+                }
+
+                const rope u(p, resource);
+
+                check("compare", sign(t.compare(u)) == sign(s.substr(pos, n).compare(p)));
+                check("compare equal", t.compare(rope(s.substr(pos, n), resource)) == 0);
+
+                r = std::move(t);
+                s = s.substr(pos, n);
+                break;
+            }
+
+            default:
+                r.append(r);  // Joined to itself.
+                s += s;
+
+                if (s.size() > 64 * rope::chunk_size) {
+                    r = r.substr(s.size() / 2);
+                    s = s.substr(s.size() / 2);
+                }
+                break;
+            }
+
+            agrees(r, s, gen);
+        }
+
+        check("view", r.view() == s && r.is_flat());
+    }
+
+    // A rope joined with, or assigned, one from another resource copies it into its own.
+    {
+        std::pmr::monotonic_buffer_resource arena;
+
+        const std::string a(3 * rope::chunk_size, 'a');
+        const std::string b(2 * rope::chunk_size, 'b');
+
+        rope x(a, resource);
+        rope y(b, &arena);
+
+        x.append(y);
+        check("joined across resources", x.str() == a + b && x.resource() == resource);
+
+        x = y;
+        check("assigned across resources", x.str() == b && x.resource() == resource);
+
+        rope z(&arena);
+        z = std::move(x);
+        check("moved across resources", z.str() == b && z.resource() == &arena);
+    }
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
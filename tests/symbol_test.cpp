@@ -0,0 +1,124 @@
+/********************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//          This program is free software : you can redistribute it and /or modify
+//          it under the terms of the GNU Affero General Public License as published by
+//          the Free Software Foundation, either version 3 of the License, or
+//          (at your option) any later version.
+//
+//          This program is distributed in the hope that it will be useful,
+//          but WITHOUT ANY WARRANTY; without even the implied warranty of
+//          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//          GNU Affero General Public License for more details.
+//
+//          You should have received a copy of the GNU Affero General Public License
+//          along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//          The author can be reached at: maxjmartin@gmail.com
+//
+/********************************************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+#include <latch>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "oliver_lang.h"
+
+/*
+    Interns an overlapping set of names from several threads at once, half in
+    the same order and half shuffled, while reading back the name of every id
+    it is given.  Every
+    thread must be given the same id for a name, and the new ids must be dense.
+    The names span several blocks of the table, so blocks are published while
+    other threads read from them.
+*/
+static int failures = 0;
+
+static void check(const char* name, bool passed) {
+
+    if (!passed) {
+        fmt::println("FAILED: {}", name);
+        ++failures;
+    }
+}
+
+int main() {
+
+    using namespace Oliver;
+
+    constexpr std::size_t threads = 8;
+    constexpr std::size_t names   = 3 * symbol_table::block_size + 100;
+
+    std::vector<std::string> keys;
+
+    for (std::size_t i = 0; i < names; ++i) {
+        keys.push_back("symbol_test_" + std::to_string(i));
+    }
+
+    const std::size_t before = symbol_table::size();
+
+    std::vector<std::vector<symbol_table::id_type>> ids(threads, std::vector<symbol_table::id_type>(names));
+    std::vector<int>                                misnamed(threads, 0);
+
+    std::latch start(threads);
+
+    {
+        std::vector<std::jthread> pool;
+
+        for (std::size_t t = 0; t < threads; ++t) {
+
+            pool.emplace_back([&, t] {
+
+                std::vector<std::size_t> order(names);
+
+                for (std::size_t i = 0; i < names; ++i) {
+                    order[i] = i;
+                }
+
+                if (t % 2) {  // The others all race for the same name at once.
+                    std::shuffle(order.begin(), order.end(), std::mt19937(static_cast<unsigned>(t)));
+                }
+
+                start.arrive_and_wait();
+
+                for (std::size_t i : order) {
+
+                    const symbol_table::id_type id = symbol_table::intern(keys[i]);
+
+                    ids[t][i]    = id;
+                    misnamed[t] += symbol_table::name(id) != keys[i];
+                }
+            });
+        }
+    }
+
+    for (std::size_t t = 0; t < threads; ++t) {
+        check("name(intern(s)) == s", misnamed[t] == 0);
+        check("the same id in every thread", ids[t] == ids[0]);
+    }
+
+    std::vector<symbol_table::id_type> sorted = ids[0];
+    std::sort(sorted.begin(), sorted.end());
+
+    check("unique", std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+    check("dense", sorted.front() == before && sorted.back() == before + names - 1);
+    check("size", symbol_table::size() == before + names);
+
+    std::size_t changed = 0;
+
+    for (std::size_t i = 0; i < names; ++i) {  // Interned again, once no other thread is adding names.
+        changed += symbol_table::intern(keys[i]) != ids[0][i];
+    }
+
+    check("interned again", changed == 0);
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
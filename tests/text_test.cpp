@@ -0,0 +1,208 @@
+/********************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//          This program is free software : you can redistribute it and /or modify
+//          it under the terms of the GNU Affero General Public License as published by
+//          the Free Software Foundation, either version 3 of the License, or
+//          (at your option) any later version.
+//
+//          This program is distributed in the hope that it will be useful,
+//          but WITHOUT ANY WARRANTY; without even the implied warranty of
+//          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//          GNU Affero General Public License for more details.
+//
+//          You should have received a copy of the GNU Affero General Public License
+//          along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//          The author can be reached at: maxjmartin@gmail.com
+//
+/********************************************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+#include "oliver_lang.h"
+
+/*
+    Checks text's code point operations against a 'std::u32string' model, on
+    multibyte text long enough that its index holds several marks, and that
+    its rope holds several chunks.  The index is built before elements are
+    dropped, so 'get' must account for the code points dropped since.
+*/
+static int failures = 0;
+
+static bool check(const char* name, bool passed) {
+
+    if (!passed) {
+        fmt::println("FAILED: {}", name);
+        ++failures;
+    }
+    return passed;
+}
+
+static std::string encode(std::u32string_view s) {
+
+    std::string result;
+
+    for (char32_t c : s) {
+
+        if (c < 0x80) {
+            result += static_cast<char>(c);
+        }
+        else if (c < 0x800) {
+            result += static_cast<char>(0xC0 | (c >> 6));
+            result += static_cast<char>(0x80 | (c & 0x3F));
+        }
+        else if (c < 0x10000) {
+            result += static_cast<char>(0xE0 | (c >> 12));
+            result += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            result += static_cast<char>(0x80 | (c & 0x3F));
+        }
+        else {
+            result += static_cast<char>(0xF0 | (c >> 18));
+            result += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+            result += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            result += static_cast<char>(0x80 | (c & 0x3F));
+        }
+    }
+
+    return result;
+}
+
+static std::string text_of(const Oliver::var& x) {
+    return fmt::format("{}", x);
+}
+
+static Oliver::var index(std::size_t i) {
+    return Oliver::var(Oliver::number(static_cast<long long>(i)));
+}
+
+// Compares the length, and every code point, with the model.
+static bool agrees(Oliver::var& t, const std::u32string& model) {
+
+    if (!check("abs", t.abs().integer_type() == static_cast<std::int64_t>(model.size()))) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < model.size(); ++i) {
+
+        if (!check("get", text_of(t.get(index(i))) == encode(model.substr(i, 1)))) {
+            fmt::println("    at code point {} of {}", i, model.size());
+            return false;
+        }
+    }
+
+    return check("get past the end", t.get(index(model.size())).is_nothing())
+        && check("str", text_of(t) == encode(model));
+}
+
+int main() {
+
+    using namespace Oliver;
+
+    std::mt19937 gen(24);
+
+    // Code points of each encoded length, avoiding the surrogates.
+    const auto code_point = [&]() -> char32_t {
+        switch (gen() % 4) {
+        case 0:  return 0x20 + gen() % 0x5F;
+        case 1:  return 0x80 + gen() % 0x780;
+        case 2:  return 0xE000 + gen() % 0x2000;
+        default: return 0x10000 + gen() % 0x100000;
+        }
+    };
+
+    std::u32string model;
+
+    for (int i = 0; i < 1000; ++i) {
+        model += code_point();
+    }
+
+    // Built whole, as a single buffer, and built a few code points at a time, as a tree of chunks.
+    var whole{ text(encode(model)) };
+    var built{ text("") };
+
+    for (std::size_t i = model.size(); i > 0;) {
+        const std::size_t n = std::min<std::size_t>(i, 1 + gen() % 7);
+        i -= n;
+        built = built.push(var(text(encode(model.substr(i, n)))));
+    }
+
+    for (var* t : { &whole, &built }) {
+
+        std::u32string m = model;
+
+        check("lead", text_of(t->lead()) == encode(m.substr(0, 1)));
+
+        agrees(*t, m);  // Builds the index.
+
+        // Dropped across several marks, so 'get' starts from a mark before the first code point.
+        for (std::size_t n : { 1, 126, 1, 129, 300 }) {
+
+            for (std::size_t i = 0; i < n; ++i) {
+                *t = t->drop();
+            }
+            m.erase(0, n);
+
+            agrees(*t, m);
+        }
+
+        const std::u32string front = U"\u00E9\u4E2D\U0001F600";
+
+        *t = t->push(var(text(encode(front))));
+        m  = front + m;
+
+        agrees(*t, m);
+
+        *t = t->reverse();
+        std::reverse(m.begin(), m.end());
+
+        agrees(*t, m);
+    }
+
+    // Each byte which does not begin a well formed sequence is replaced by U+FFFD.
+    const std::u32string bad = U"\uFFFD";
+
+    const std::pair<std::string, std::u32string> repairs[] = {
+        { "a\xC3",                  U"a" + bad },                    // Truncated.
+        { "\xE2\x82" "b",           bad + bad + U"b" },              // Truncated, then continued.
+        { "\xFF" "c",               bad + U"c" },                    // Never valid.
+        { "\xC0\xAF",               bad + bad },                     // Overlong.
+        { "\xED\xA0\x80",           bad + bad + bad },               // A surrogate.
+        { "\xF4\x90\x80\x80",       bad + bad + bad + bad },         // Above U+10FFFF.
+        { "\x80" "\xC3\xA9",        bad + U"\u00E9" },          // A lone continuation.
+    };
+
+    for (const auto& [input, expected] : repairs) {
+        var t{ text(input) };
+        agrees(t, expected);
+    }
+
+    // Invalid input within long text, so that the repair is indexed across marks.
+    {
+        std::string    input;
+        std::u32string expected;
+
+        for (int i = 0; i < 400; ++i) {
+            const std::u32string c(1, code_point());
+            input    += encode(c);
+            expected += c;
+
+            if (i % 37 == 0) {
+                input    += '\xFE';
+                expected += bad;
+            }
+        }
+
+        var t{ text(input) };
+        agrees(t, expected);
+    }
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+/********************************************************************************************/
+//
+//                           Copyright(C) 2024 Max J Martin
+//
+//                            This file is part of Oliver.
+//                      Oliver is program language interpreter.
+//
+//          This program is free software : you can redistribute it and /or modify
+//          it under the terms of the GNU Affero General Public License as published by
+//          the Free Software Foundation, either version 3 of the License, or
+//          (at your option) any later version.
+//
+//          This program is distributed in the hope that it will be useful,
+//          but WITHOUT ANY WARRANTY; without even the implied warranty of
+//          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//          GNU Affero General Public License for more details.
+//
+//          You should have received a copy of the GNU Affero General Public License
+//          along with this program.If not, see <https://www.gnu.org/licenses/>.
+//
+//          The author can be reached at: maxjmartin@gmail.com
+//
+/********************************************************************************************/
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+#include "oliver_lang.h"
+
+/*
+    Round-trips each kind of scalar through a value, both directly and from
+    a var, and checks that anything which does not fit is boxed, and that a
+    boxed value is copied and moved as its var.
+*/
+static int failures = 0;
+
+static void check(const char* name, bool passed) {
+
+    if (!passed) {
+        fmt::println("FAILED: {}", name);
+        ++failures;
+    }
+}
+
+static Oliver::var real(double x) {
+    return Oliver::var(Oliver::number(std::complex<double>(x, 0.0)));
+}
+
+static Oliver::var integer(long long x) {
+    return Oliver::var(Oliver::number(x));
+}
+
+int main() {
+
+    using namespace Oliver;
+
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+
+    // Reals, including those whose bits lie near the tags.
+    check("NaN",           value(nan).is_real() && std::isnan(value(nan).as_real()));
+    check("-NaN",          value(-nan).is_real() && std::isnan(value(-nan).as_real()));
+    check("NaN from var",  value(real(nan)).is_real() && std::isnan(value(real(nan)).as_real()));
+    check("+0.0",          value(0.0).is_real() && value(0.0).as_real() == 0.0 && !std::signbit(value(0.0).as_real()));
+    check("-0.0",          value(-0.0).is_real() && value(-0.0).as_real() == 0.0 && std::signbit(value(-0.0).as_real()));
+    check("+inf",          value(inf).is_real() && value(inf).as_real() == inf);
+    check("-inf",          value(-inf).is_real() && value(-inf).as_real() == -inf);
+    check("-inf from var", value(real(-inf)).is_real() && value(real(-inf)).as_real() == -inf);
+    check("2.5 to var",    value(real(2.5)).to_var() == real(2.5));
+
+    // Integers within an int32 are held in place, and those just past it are boxed.
+    constexpr long long lo = std::numeric_limits<std::int32_t>::min();
+    constexpr long long hi = std::numeric_limits<std::int32_t>::max();
+
+    check("int32 min",      value(integer(lo)).is_integer() && value(integer(lo)).as_integer() == lo);
+    check("int32 max",      value(integer(hi)).is_integer() && value(integer(hi)).as_integer() == hi);
+    check("int32 min back", value(integer(lo)).to_var() == integer(lo));
+    check("int32 max back", value(integer(hi)).to_var() == integer(hi));
+    check("-1",             value(std::int32_t(-1)).as_integer() == -1 && value(std::int32_t(-1)).as_real() == -1.0);
+    check("int32 min - 1",  value(integer(lo - 1)).is_boxed() && value(integer(lo - 1)).to_var() == integer(lo - 1));
+    check("int32 max + 1",  value(integer(hi + 1)).is_boxed() && value(integer(hi + 1)).to_var() == integer(hi + 1));
+    check("int32 == real",  value(std::int32_t(3)) == value(3.0));
+
+    // Crisp booleans, op codes, symbols and nothing.
+    check("true",           value(true).is_boolean() && value(true).as_boolean());
+    check("false",          value(false).is_boolean() && !value(false).as_boolean());
+    check("true from var",  value(var(boolean(true))).is_boolean() && value(var(boolean(true))).as_boolean());
+    check("true back",      value(true).to_var() == var(boolean(true)));
+    check("op code",        value(op_code::ADD_op).is_op_code() && value(op_code::ADD_op).as_op_code() == op_code::ADD_op);
+    check("op code back",   value(var(op_call(op_code::MUL_op))).as_op_code() == op_code::MUL_op);
+    check("symbol",         value(symbol("value_test")).is_symbol() && value(symbol("value_test")).as_symbol().id() == symbol("value_test").id());
+    check("symbol back",    value(var(symbol("value_test"))).to_var() == var(symbol("value_test")));
+    check("nothing",        value().is_nothing() && value(var()).is_nothing() && value().to_var().is_nothing());
+
+    // A boxed value is copied and moved as its var.
+    {
+        const var s{ text("boxed") };
+
+        value a(s);
+        check("text boxed", a.is_boxed() && a.to_var() == s);
+
+        value b = a;
+        check("copied", b.is_boxed() && b == a && b.to_var() == s);
+
+        value c = std::move(a);
+        check("moved", c.is_boxed() && c.to_var() == s && a.is_nothing());
+
+        a = c;
+        check("copy assigned", a.is_boxed() && a == c);
+
+        b = value(std::int32_t(7));
+        check("assigned over a boxed value", b.is_integer() && b.as_integer() == 7);
+
+        c = std::move(b);
+        check("move assigned over a boxed value", c.is_integer() && c.as_integer() == 7 && b.is_nothing());
+
+        const value& same = a;
+        a = same;
+        check("self assigned", a.is_boxed() && a.to_var() == s);
+    }
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}